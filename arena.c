@@ -0,0 +1,249 @@
+/*******************************************************************************************
+*
+*   raylib study [arena.c] - Pong _ multi-ball arena
+*
+*   Game licensed under MIT.
+*
+********************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "arena.h"
+
+#define ARENA_PI 3.14159265358979323846f
+
+// xorshift32 - arena keeps its own stream so it never touches raylib's random state
+static float arena_rand(Arena *arena) {
+    unsigned int x = arena->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    arena->seed = x;
+    return (x >> 8) * (1.0f/16777216.0f);
+}
+
+static int arena_cell_of(Arena *arena, float x, float y) {
+    int cx = (int)((x - arena->bounds.x) * arena->inv_cell_size);
+    int cy = (int)((y - arena->bounds.y) * arena->inv_cell_size);
+    // balls leaving through the goals are parked in the border cells
+    if (cx < 0) cx = 0;
+    if (cy < 0) cy = 0;
+    if (cx >= arena->grid_w) cx = arena->grid_w - 1;
+    if (cy >= arena->grid_h) cy = arena->grid_h - 1;
+    return cy*arena->grid_w + cx;
+}
+
+static void arena_link(Arena *arena, int i, int c) {
+    int head = arena->cell_head[c];
+    arena->cell[i] = c;
+    arena->prev[i] = -1;
+    arena->next[i] = head;
+    if (head >= 0) arena->prev[head] = i;
+    arena->cell_head[c] = i;
+}
+
+static void arena_unlink(Arena *arena, int i) {
+    int p = arena->prev[i];
+    int n = arena->next[i];
+    if (p >= 0) arena->next[p] = n;
+    else arena->cell_head[arena->cell[i]] = n;
+    if (n >= 0) arena->prev[n] = p;
+}
+
+// same launch cone as random_angle() in main.c - 45/95 degree to the up or bottom
+static void arena_launch(Arena *arena, int i) {
+    float side = (arena_rand(arena) < 0.5f) ? -1.0f : 1.0f;
+    float up = (arena_rand(arena) < 0.5f) ? -1.0f : 1.0f;
+    float angle = (45.0f + arena_rand(arena)*50.0f) * (ARENA_PI/180.0f);
+    arena->vel_x[i] = side * sinf(angle) * arena->speed;
+    arena->vel_y[i] = up * cosf(angle) * arena->speed;
+}
+
+bool arena_init(Arena *arena, int capacity, Rectangle bounds, float radius, float speed, unsigned int seed) {
+    memset(arena, 0, sizeof(*arena));
+    arena->capacity = capacity;
+    arena->radius = radius;
+    arena->speed = speed;
+    arena->bounds = bounds;
+    arena->seed = seed ? seed : 0x9E3779B9u;
+    // a cell as wide as a ball so only the 8 neighbours can touch
+    arena->cell_size = radius*2.0f;
+    arena->inv_cell_size = 1.0f/arena->cell_size;
+    arena->grid_w = (int)ceilf(bounds.width*arena->inv_cell_size) + 1;
+    arena->grid_h = (int)ceilf(bounds.height*arena->inv_cell_size) + 1;
+
+    arena->pos_x = malloc(sizeof(float)*capacity);
+    arena->pos_y = malloc(sizeof(float)*capacity);
+    arena->vel_x = malloc(sizeof(float)*capacity);
+    arena->vel_y = malloc(sizeof(float)*capacity);
+    arena->cell = malloc(sizeof(int)*capacity);
+    arena->next = malloc(sizeof(int)*capacity);
+    arena->prev = malloc(sizeof(int)*capacity);
+    arena->cell_head = malloc(sizeof(int)*arena->grid_w*arena->grid_h);
+    if (!arena->pos_x || !arena->pos_y || !arena->vel_x || !arena->vel_y ||
+        !arena->cell || !arena->next || !arena->prev || !arena->cell_head) {
+        arena_free(arena);
+        return false;
+    }
+    arena_clear(arena);
+    return true;
+}
+
+void arena_free(Arena *arena) {
+    free(arena->pos_x);
+    free(arena->pos_y);
+    free(arena->vel_x);
+    free(arena->vel_y);
+    free(arena->cell);
+    free(arena->next);
+    free(arena->prev);
+    free(arena->cell_head);
+    memset(arena, 0, sizeof(*arena));
+}
+
+void arena_clear(Arena *arena) {
+    arena->count = 0;
+    for (int c=0; c<arena->grid_w*arena->grid_h; c++) arena->cell_head[c] = -1;
+}
+
+// returns the new ball index or -1 when the pool is full, zero direction picks a random one
+int arena_spawn(Arena *arena, Vector2 position, Vector2 direction) {
+    if (arena->count >= arena->capacity) return -1;
+    int i = arena->count++;
+    arena->pos_x[i] = position.x;
+    arena->pos_y[i] = position.y;
+    if (direction.x == 0.0f && direction.y == 0.0f) {
+        arena_launch(arena, i);
+    } else {
+        arena->vel_x[i] = direction.x * arena->speed;
+        arena->vel_y[i] = direction.y * arena->speed;
+    }
+    arena_link(arena, i, arena_cell_of(arena, position.x, position.y));
+    return i;
+}
+
+static void arena_hit_paddle(Arena *arena, int i, Rectangle rec) {
+    float r = arena->radius;
+    float x = arena->pos_x[i], y = arena->pos_y[i];
+    float cx = (x < rec.x) ? rec.x : (x > rec.x + rec.width) ? rec.x + rec.width : x;
+    float cy = (y < rec.y) ? rec.y : (y > rec.y + rec.height) ? rec.y + rec.height : y;
+    float dx = x - cx, dy = y - cy;
+    if (dx*dx + dy*dy > r*r) return;
+    // only bounce while approaching - one hit per approach
+    float mid_x = rec.x + rec.width/2.0f;
+    float heading = (x < mid_x) ? -1.0f : 1.0f;
+    if (arena->vel_x[i]*heading >= 0.0f) return;
+    // same shape as move_ball: offset from the paddle center maps to +-45 degree
+    float s = sqrtf(arena->vel_x[i]*arena->vel_x[i] + arena->vel_y[i]*arena->vel_y[i]);
+    float b = ((rec.y + rec.height/2.0f) - y) / (rec.height/2.0f);
+    if (b > 1.0f) b = 1.0f;
+    if (b < -1.0f) b = -1.0f;
+    float c = b * (45.0f*ARENA_PI/180.0f);
+    arena->vel_x[i] = heading * cosf(c) * s;
+    arena->vel_y[i] = -sinf(c) * s;
+    arena->pos_x[i] = (heading < 0.0f) ? rec.x - r : rec.x + rec.width + r;
+    arena->stats.paddle_hits++;
+}
+
+static void arena_collide_pair(Arena *arena, int i, int j) {
+    float min_d = arena->radius*2.0f;
+    float dx = arena->pos_x[j] - arena->pos_x[i];
+    float dy = arena->pos_y[j] - arena->pos_y[i];
+    float d2 = dx*dx + dy*dy;
+    arena->stats.pair_tests++;
+    if (d2 >= min_d*min_d) return;
+    float d = sqrtf(d2);
+    float nx, ny;
+    if (d2 > 0.0f) {
+        nx = dx/d;
+        ny = dy/d;
+    } else {
+        // same spot (spawns and relaunches start at the center) - split along a random axis
+        float angle = arena_rand(arena)*2.0f*ARENA_PI;
+        nx = cosf(angle);
+        ny = sinf(angle);
+    }
+    // push apart half the overlap each
+    float push = (min_d - d)*0.5f;
+    arena->pos_x[i] -= nx*push;
+    arena->pos_y[i] -= ny*push;
+    arena->pos_x[j] += nx*push;
+    arena->pos_y[j] += ny*push;
+    // equal mass elastic - swap the normal components when approaching
+    float rel = (arena->vel_x[i] - arena->vel_x[j])*nx + (arena->vel_y[i] - arena->vel_y[j])*ny;
+    if (rel <= 0.0f) return;
+    arena->vel_x[i] -= rel*nx;
+    arena->vel_y[i] -= rel*ny;
+    arena->vel_x[j] += rel*nx;
+    arena->vel_y[j] += rel*ny;
+    arena->stats.ball_hits++;
+}
+
+void arena_step(Arena *arena, float dt) {
+    float r = arena->radius;
+    float top = arena->bounds.y + r;
+    float bottom = arena->bounds.y + arena->bounds.height - r;
+    float left = arena->bounds.x - r;
+    float right = arena->bounds.x + arena->bounds.width + r;
+    Vector2 center = {arena->bounds.x + arena->bounds.width/2.0f, arena->bounds.y + arena->bounds.height/2.0f};
+    memset(&arena->stats, 0, sizeof(arena->stats));
+
+    // integrate, walls, paddles, goals and grid relink in one pass over the pool
+    for (int i=0; i<arena->count; i++) {
+        arena->pos_x[i] += arena->vel_x[i]*dt;
+        arena->pos_y[i] += arena->vel_y[i]*dt;
+        if (arena->pos_y[i] < top) {
+            arena->pos_y[i] = top;
+            arena->vel_y[i] = fabsf(arena->vel_y[i]);
+            arena->stats.wall_hits++;
+        } else if (arena->pos_y[i] > bottom) {
+            arena->pos_y[i] = bottom;
+            arena->vel_y[i] = -fabsf(arena->vel_y[i]);
+            arena->stats.wall_hits++;
+        }
+        for (int p=0; p<arena->paddle_count; p++) arena_hit_paddle(arena, i, arena->paddles[p]);
+        if (arena->pos_x[i] < left || arena->pos_x[i] > right) {
+            arena->stats.goals[(arena->pos_x[i] < left) ? ARENA_SIDE_LEFT : ARENA_SIDE_RIGHT]++;
+            arena->pos_x[i] = center.x;
+            arena->pos_y[i] = center.y;
+            arena_launch(arena, i);
+        }
+        int c = arena_cell_of(arena, arena->pos_x[i], arena->pos_y[i]);
+        if (c != arena->cell[i]) {
+            arena_unlink(arena, i);
+            arena_link(arena, i, c);
+            arena->stats.relinked++;
+        }
+    }
+
+    // narrow phase - rest of the own cell plus 4 forward neighbours, every pair once
+    static const int offsets[4][2] = {{1,0},{-1,1},{0,1},{1,1}};
+    for (int i=0; i<arena->count; i++) {
+        int c = arena->cell[i];
+        int cx = c % arena->grid_w;
+        int cy = c / arena->grid_w;
+        for (int j=arena->next[i]; j>=0; j=arena->next[j]) arena_collide_pair(arena, i, j);
+        for (int k=0; k<4; k++) {
+            int nx = cx + offsets[k][0];
+            int ny = cy + offsets[k][1];
+            if (nx < 0 || nx >= arena->grid_w || ny >= arena->grid_h) continue;
+            for (int j=arena->cell_head[ny*arena->grid_w + nx]; j>=0; j=arena->next[j]) arena_collide_pair(arena, i, j);
+        }
+    }
+}
+
+// closest ball moving towards x, heading -1 for the left side and 1 for the right
+int arena_nearest_incoming(Arena *arena, float x, int heading) {
+    int best = -1;
+    float best_d = 0.0f;
+    for (int i=0; i<arena->count; i++) {
+        if (arena->vel_x[i]*heading <= 0.0f) continue;
+        float d = fabsf(x - arena->pos_x[i]);
+        if (best < 0 || d < best_d) {
+            best = i;
+            best_d = d;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,50 @@
+/*******************************************************************************************
+*
+*   raylib study [arena.h] - Pong _ multi-ball arena
+*
+*   Chaos mode: many balls bouncing off each other, the walls and any number of paddles.
+*   Balls live in pooled, contiguous storage (struct of arrays) and ball-ball contacts go
+*   through a uniform grid broadphase that is updated incrementally every tick: a ball is
+*   only relinked when it crosses into another cell.
+*
+*   Only raylib types are used here (no raylib calls) so the headless benchmark can link
+*   this file without a window or GL context.
+*
+********************************************************************************************/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#define ARENA_MAX_PADDLES 8
+
+typedef enum ArenaSide { ARENA_SIDE_LEFT = 0, ARENA_SIDE_RIGHT } ArenaSide;
+
+typedef struct Arena {
+    int count, capacity;
+    float radius, speed;
+    Rectangle bounds;
+    // pooled ball storage - index [0,count) is alive
+    float *pos_x, *pos_y, *vel_x, *vel_y;
+    int *cell, *next, *prev;
+    // uniform grid - one intrusive doubly linked list per cell
+    int grid_w, grid_h;
+    float cell_size, inv_cell_size;
+    int *cell_head;
+    // paddles are refreshed by the caller every tick
+    int paddle_count;
+    Rectangle paddles[ARENA_MAX_PADDLES];
+    unsigned int seed;
+    struct ArenaStats {int relinked, pair_tests, ball_hits, paddle_hits, wall_hits, goals[2];} stats;
+} Arena;
+
+bool arena_init(Arena *arena, int capacity, Rectangle bounds, float radius, float speed, unsigned int seed);
+void arena_free(Arena *arena);
+void arena_clear(Arena *arena);
+int arena_spawn(Arena *arena, Vector2 position, Vector2 direction);
+void arena_step(Arena *arena, float dt);
+int arena_nearest_incoming(Arena *arena, float x, int heading);
+
+#endif // ARENA_H
@@ -0,0 +1,227 @@
+/*******************************************************************************************
+*
+*   raylib study [lookahead.c] - Pong _ monte carlo lookahead for the computer paddle
+*
+*   Game licensed under MIT.
+*
+********************************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "lookahead.h"
+
+#define LOOKAHEAD_EXPLORE 0.8f /* ucb1 exploration, results are in [-1,1] */
+#define LOOKAHEAD_CHECK_TICKS 16 /* clock reads inside a rollout, power of two */
+#define LOOKAHEAD_COST_DECAY 0.9f /* per frame, the cost estimate forgets a slow rollout over ~20 frames */
+
+// where on the paddle to meet the ball, in half paddle heights - same as the return angle over 45 degrees
+static const float aims[LOOKAHEAD_AIMS] = {-0.8f, -0.4f, 0.0f, 0.4f, 0.8f};
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec*1e6 + ts.tv_nsec*1e-3;
+}
+
+// xorshift32 - the search keeps its own stream so it never touches raylib's random state
+static unsigned int lookahead_rand(unsigned int *seed) {
+    unsigned int x = *seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *seed = x;
+    return x;
+}
+
+static float clampf(float value, float min, float max) {
+    return value < min ? min : (value > max ? max : value);
+}
+
+// straight line to the computer's paddle face, folded back between the walls
+static float intercept_y(const Rules *r, const RulesState *s) {
+    float top = r->wall_w + r->radius, span = r->height - 2*(r->wall_w + r->radius);
+    float t = (s->ball.position.x - (r->computer_home_x + r->paddle_w + r->radius)) / -s->ball.velocity.x;
+    float y = s->ball.position.y + s->ball.velocity.y*fmaxf(t, 0.0f) - top;
+    y = fmodf(y, 2*span);
+    if (y < 0) y += 2*span;
+    if (y > span) y = 2*span - y;
+    return top + y;
+}
+
+// paddle top that meets the ball at the aim, or home while the ball is going away
+static float plan_target(const Rules *r, const RulesState *s, float aim) {
+    if (s->ball.velocity.x >= 0) return r->computer_home_y;
+    float center = intercept_y(r, s) + r->radius/2.0f + aim*r->paddle_h/2.0f;
+    return clampf(center - r->paddle_h/2.0f, r->font_size + 2, r->height - (r->paddle_h + r->paddle_w));
+}
+
+// the search side of the shared rules - its own random stream, the plan decides the computer smash
+typedef struct Rollout {
+    unsigned int *seed;
+    bool smash;
+} Rollout;
+
+static int rollout_random(void *data, int min, int max) {
+    Rollout *rollout = data;
+    return min + (int)(lookahead_rand(rollout->seed) % (unsigned int)(max - min + 1));
+}
+
+static bool rollout_smash(void *data, TelemetrySide side) {
+    Rollout *rollout = data;
+    // one in four like the game's generate_rand
+    if (side == TELEMETRY_HUMAN) return (lookahead_rand(rollout->seed) & 3) == 0;
+    return rollout->smash;
+}
+
+// one tick of the rules with the human on the paddle ai and the computer on the plan
+// returns +1 computer scored, -1 human scored, 0 otherwise - hit tells who touched the ball
+static int rules_step(const Rules *r, RulesState *s, float aim, Rollout *rollout, float dt, TelemetrySide *hit) {
+    RulesHooks hooks = {rollout, rollout_random, rollout_smash, NULL, NULL};
+    *hit = rules_move_ball(r, s, dt, &hooks);
+    s->human.velocity = rules_track(r, &s->human, &s->ball, TELEMETRY_HUMAN);
+    rules_move_paddle(r, &s->human, TELEMETRY_HUMAN, dt);
+    s->computer.velocity = s->computer.corner_hit ? 0 : lookahead_steer(s->computer.position.y, plan_target(r, s, aim), r->paddle_speed, r->paddle_max_speed, dt);
+    rules_move_paddle(r, &s->computer, TELEMETRY_COMPUTER, dt);
+    if (s->ball.position.x < 0) return -1;
+    if (s->ball.position.x > r->width) return 1;
+    return 0;
+}
+
+// plays the plan for this approach, later approaches meet the ball in the middle without smash
+// ends on a point, or with a draw once the human has sent the ball back
+// past the deadline (0 is none) it gives up and returns NAN, the result is not counted
+static float rollout(Lookahead *lookahead, const RulesState *state, int plan, float dt, double deadline) {
+    RulesState s = *state;
+    float aim = aims[plan % LOOKAHEAD_AIMS];
+    Rollout hooks = {&lookahead->seed, plan >= LOOKAHEAD_AIMS};
+    bool returned = false;
+    int ticks = (int)(LOOKAHEAD_HORIZON/dt);
+    for (int t=0; t<ticks; t++) {
+        if (deadline > 0 && (t & (LOOKAHEAD_CHECK_TICKS - 1)) == LOOKAHEAD_CHECK_TICKS - 1 && now_us() > deadline) return NAN;
+        TelemetrySide hit;
+        int point = rules_step(&lookahead->rules, &s, aim, &hooks, dt, &hit);
+        if (point) return (float)point;
+        if (hit == TELEMETRY_COMPUTER) returned = true;
+        if (hit == TELEMETRY_HUMAN && returned) return 0.0f;
+        if (hit == TELEMETRY_COMPUTER) {
+            aim = 0.0f;
+            hooks.smash = false;
+        }
+    }
+    return 0.0f;
+}
+
+static int pick_plan(const Lookahead *lookahead, int total) {
+    int best = 0;
+    float best_score = -INFINITY;
+    for (int p=0; p<LOOKAHEAD_PLANS; p++) {
+        if (lookahead->visits[p] == 0) return p;
+        float score = lookahead->value[p]/lookahead->visits[p] + LOOKAHEAD_EXPLORE*sqrtf(logf((float)total)/lookahead->visits[p]);
+        if (score > best_score) {
+            best_score = score;
+            best = p;
+        }
+    }
+    return best;
+}
+
+static int best_plan(const Lookahead *lookahead) {
+    int best = LOOKAHEAD_AIMS/2; /* middle of the paddle, no smash */
+    float best_mean = -INFINITY;
+    for (int p=0; p<LOOKAHEAD_PLANS; p++) {
+        if (lookahead->visits[p] == 0) continue;
+        float mean = lookahead->value[p]/lookahead->visits[p];
+        if (mean > best_mean) {
+            best_mean = mean;
+            best = p;
+        }
+    }
+    return best;
+}
+
+void lookahead_init(Lookahead *lookahead, Rules rules, float budget_us, unsigned int seed) {
+    memset(lookahead, 0, sizeof(*lookahead));
+    lookahead->rules = rules;
+    lookahead->budget_us = budget_us;
+    lookahead->max_rollouts = LOOKAHEAD_MAX_ROLLOUTS;
+    lookahead->seed = seed ? seed : 0x2545F491u;
+    lookahead->plan = LOOKAHEAD_AIMS/2;
+    lookahead->target_y = rules.computer_home_y;
+}
+
+// once per frame before the rules run
+void lookahead_update(Lookahead *lookahead, const RulesState *state, float dt) {
+    lookahead->stats.last_rollouts = 0;
+    lookahead->stats.last_us = 0;
+    if (state->ball.velocity.x >= 0 || state->computer.corner_hit || dt <= 0) {
+        // nothing to decide until the ball heads for the computer
+        lookahead->searching = false;
+        lookahead->plan = LOOKAHEAD_AIMS/2;
+        lookahead->target_y = plan_target(&lookahead->rules, state, 0.0f);
+        return;
+    }
+    if (!lookahead->searching) {
+        lookahead->searching = true;
+        memset(lookahead->visits, 0, sizeof(lookahead->visits));
+        memset(lookahead->value, 0, sizeof(lookahead->value));
+    }
+    bool timed = lookahead->budget_us > 0;
+    double start = now_us(), deadline = start + lookahead->budget_us;
+    // slowest rollout lately - a preempted one fades out instead of stalling the search
+    lookahead->rollout_us *= LOOKAHEAD_COST_DECAY;
+    int total = 0;
+    for (int p=0; p<LOOKAHEAD_PLANS; p++) total += lookahead->visits[p];
+    int n = 0;
+    double now = start;
+    while (n < lookahead->max_rollouts) {
+        // stop before a rollout that might not fit, one that runs over stops itself
+        if (timed && now + lookahead->rollout_us > deadline) break;
+        int plan = pick_plan(lookahead, total + 1);
+        float value = rollout(lookahead, state, plan, dt, timed ? deadline : 0);
+        if (isnan(value)) {
+            now = now_us();
+            break;
+        }
+        lookahead->value[plan] += value;
+        lookahead->visits[plan]++;
+        total++;
+        n++;
+        if (timed) {
+            double end = now_us();
+            lookahead->rollout_us = fmaxf(lookahead->rollout_us, (float)(end - now));
+            now = end;
+        }
+    }
+    float elapsed = (float)((timed ? now : now_us()) - start);
+    lookahead->stats.frames++;
+    lookahead->stats.rollouts += n;
+    lookahead->stats.last_rollouts = n;
+    lookahead->stats.last_us = elapsed;
+    if (elapsed > lookahead->stats.worst_us) lookahead->stats.worst_us = elapsed;
+    if (timed && elapsed > lookahead->budget_us) lookahead->stats.overruns++;
+    lookahead->plan = best_plan(lookahead);
+    lookahead->target_y = plan_target(&lookahead->rules, state, aims[lookahead->plan % LOOKAHEAD_AIMS]);
+}
+
+// after a point - the next approach starts a new search even when the serve heads left again
+void lookahead_reset(Lookahead *lookahead) {
+    lookahead->searching = false;
+    lookahead->plan = LOOKAHEAD_AIMS/2;
+    lookahead->target_y = lookahead->rules.computer_home_y;
+}
+
+// paddle top y the computer should head for this frame
+float lookahead_target(const Lookahead *lookahead) {
+    return lookahead->target_y;
+}
+
+bool lookahead_smash(const Lookahead *lookahead) {
+    return lookahead->plan >= LOOKAHEAD_AIMS;
+}
+
+// paddle velocity that lands on the target this frame once move_*_paddle damps it by 0.8
+float lookahead_steer(float y, float target, float speed, float max_speed, float dt) {
+    if (dt <= 0 || speed <= 0) return 0;
+    return clampf((target - y)/(0.8f*speed*dt), -max_speed, max_speed);
+}
@@ -0,0 +1,49 @@
+/*******************************************************************************************
+*
+*   raylib study [lookahead.h] - Pong _ monte carlo lookahead for the computer paddle
+*
+*   Anytime search over a few plans for the next hit: where on the paddle to meet the ball
+*   (which sets the return angle) and whether to smash. Every frame of an approach runs
+*   short rollouts from the current state until the microsecond budget is spent, results
+*   add up over the frames of the approach and start over with the next one. The computer
+*   plays the plan with the best mean so far.
+*
+*   Rollouts step the same rules as the game (rules.h) with the human played by the paddle
+*   ai. No raylib calls here, the search keeps its own random stream so the game's stays
+*   untouched.
+*
+********************************************************************************************/
+
+#ifndef LOOKAHEAD_H
+#define LOOKAHEAD_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "rules.h"
+
+#define LOOKAHEAD_AIMS 5
+#define LOOKAHEAD_PLANS (LOOKAHEAD_AIMS*2) /* every aim with and without smash */
+#define LOOKAHEAD_MAX_ROLLOUTS 4096 /* per frame, also the count when there is no time budget */
+#define LOOKAHEAD_HORIZON 2.5f /* seconds */
+
+typedef struct Lookahead {
+    Rules rules;
+    float budget_us; /* <= 0 runs max_rollouts every frame, same result on every machine */
+    int max_rollouts;
+    unsigned int seed;
+    // search over the current approach
+    bool searching;
+    int plan, visits[LOOKAHEAD_PLANS];
+    float value[LOOKAHEAD_PLANS];
+    float target_y, rollout_us;
+    struct LookaheadStats {long frames, rollouts, overruns; int last_rollouts; float last_us, worst_us;} stats;
+} Lookahead;
+
+void lookahead_init(Lookahead *lookahead, Rules rules, float budget_us, unsigned int seed);
+void lookahead_update(Lookahead *lookahead, const RulesState *state, float dt);
+void lookahead_reset(Lookahead *lookahead);
+float lookahead_target(const Lookahead *lookahead);
+bool lookahead_smash(const Lookahead *lookahead);
+float lookahead_steer(float y, float target, float speed, float max_speed, float dt);
+
+#endif // LOOKAHEAD_H
@@ -24,8 +24,13 @@
 #include <math.h>
 #include "raylib.h"
 #include "raymath.h"
+#include "arena.h"
+#include "telemetry.h"
+#include "rules.h"
+#include "lookahead.h"
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
+    #include <emscripten/html5.h>
     #define GLSL_VERSION 100
 #else
     #define GLSL_VERSION 330
@@ -53,6 +58,17 @@
 #define _WINDOW_W 640
 #define _WINDOW_H 360
 #define MAX_SCORE 99999
+#define ARENA_MAX_BALLS 512
+#define ARENA_START_BALLS 8
+#define ARENA_SPAWN_FRAMES 20
+#define ARENA_SFX_FRAMES 6 /* one sound per kind this often, dense scenes hit every tick */
+#define LOOKAHEAD_BUDGET_US 500.0f /* hard ai */
+#define TICK_RATE 60 /* frame counted timers assume this */
+#define IDLE_FPS 15
+#define HIDDEN_FPS 4
+#define IDLE_AFTER_FRAMES 20 /* picture unchanged this long -> idle */
+#define MAX_CATCHUP_TICKS 8
+#define MAX_QUEUED_KEYS 16 /* raylib's key pressed queue */
 
 typedef struct Screen {
     int canvas_width,canvas_height;
@@ -63,12 +79,21 @@ typedef struct Screen {
     Texture2D logo_raylib;
     Rectangle source,dest;
     Shader shader;
+    // on demand rendering - PONG_ON_DEMAND=0 draws and presents every frame
+    bool on_demand, idle, hidden, resume, changed, scene_valid;
+    unsigned long long scene_key;
+    int still_frames;
+    float tick_debt;
+    // catch-up ticks of an idle frame step a fixed 1/TICK_RATE, key edges count on the first
+    bool catchup;
+    int tick, key_count, keys[MAX_QUEUED_KEYS];
+    struct RenderStats {long frames, ticks, scenes, presents;} stats;
 } Screen;
 
 typedef struct Board {
     int wall_w;
     int font_size;
-    bool blink, ai_status;
+    bool blink, ai_status, arena_mode, debug;
     Font font;
     Color score_text_color,shadow_color;
     Vector2 human_score_text,computer_score_text;
@@ -76,7 +101,10 @@ typedef struct Board {
     struct Sfx {
         Sound logo_intro,logo_intro_final,start,count,count_last,hit_wall,hit_paddle, hit_paddle_smash,hit_paddle_smash_back,reset;
     } sfx;
-    struct Timer {int frame_counter,current_frame,count_timer,blink_timer;} timer;
+    struct Timer {int frame_counter,current_frame,count_timer,blink_timer,arena_sfx[3];} timer;
+    Telemetry *telemetry;
+    Rules rules;
+    Lookahead *lookahead;
 } Board;
 
 typedef struct Ball {
@@ -100,7 +128,7 @@ typedef struct Paddle {
     struct Helper {Vector2 position; Rectangle rec; Color color;} helper;
 } Paddle;
 
-typedef enum GameScreen { LOGO = 0, TITLE, START, GAMEPLAY, RESET, ENDING } GameScreen;
+typedef enum GameScreen { LOGO = 0, TITLE, START, GAMEPLAY, RESET, ENDING, ARENA } GameScreen;
 
 typedef struct Context {
     Screen screen;
@@ -109,8 +137,14 @@ typedef struct Context {
     Paddle human;
     Paddle computer;
     Ball ball;
+    Arena arena;
 } Context;
 
+// match telemetry - enabled with PONG_TELEMETRY=<file>, too big for the stack on web
+static Telemetry telemetry;
+// computer ai search - the hard ai, H on the title toggles it against the coin flip ai
+// PONG_AI_BUDGET_US=<microseconds per frame> starts with it on at that budget
+static Lookahead lookahead;
 
 void LoadResources(Screen *screen, Board *board) {
     // shader
@@ -137,17 +171,36 @@ void LoadResources(Screen *screen, Board *board) {
 Vector2 move_ball(Screen *screen, Board *board, Ball *ball, Paddle *human, Paddle *computer);
 Vector2 move_human_paddle(Screen *screen, Board *board, Paddle *human, Ball *ball);
 Vector2 move_computer_paddle(Screen *screen, Board *board, Paddle *human, Ball *ball);
+void record_event(Board *board, TelemetryEvent type, TelemetrySide side, RulesBall ball);
+RulesBall ball_state(Ball *ball);
+RulesPaddle paddle_state(Paddle *paddle);
+RulesState capture_state(Ball *ball, Paddle *human, Paddle *computer);
 void draw_logo(Screen *screen, Board *board);
 void draw_title(Screen *screen, Board *board);
 void draw_board(Screen *screen, Board *board);
 void draw_ai_status(Board *board, Paddle *human);
+void draw_debug(Screen *screen, Board *board);
 void draw_smash_status(Screen *screen, Board *board, Paddle *human, Paddle *computer);
 void draw_ball(Board *board, Ball *ball);
 void draw_human_paddle(Board *board, Paddle *human);
 void draw_computer_paddle(Board *board, Paddle *computer);
 void draw_score(Board *board, Paddle *human, Paddle *computer);
-void UpdateDrawFrame(Screen*, GameScreen*, Board*, Paddle*, Paddle*, Ball*);
+void draw_arena(Board *board, Arena *arena);
+void UpdateDrawFrame(Screen*, GameScreen*, Board*, Paddle*, Paddle*, Ball*, Arena*);
+void UpdateFrame(Screen*, GameScreen*, Board*, Paddle*, Paddle*, Ball*, Arena*);
+void DrawFrame(Screen*, GameScreen*, Board*, Paddle*, Paddle*, Ball*, Arena*, bool scene, bool present);
+unsigned long long scene_key(GameScreen current_screen, Board *board, Paddle *human, Paddle *computer, Ball *ball, Arena *arena);
+void set_frame_rate(Screen *screen);
+bool window_hidden(void);
+float frame_time(Screen *screen);
+bool key_pressed(Screen *screen, int key);
+#if defined(PLATFORM_WEB)
+EM_BOOL on_visibility_change(int type, const EmscriptenVisibilityChangeEvent *event, void *data);
+#endif
+void reset_paddle(Paddle *paddle);
 void UpdateWeb(Context *arg);
+void InitGame(Context *ctx);
+void UnloadGame(Context *ctx);
 
 Vector2 random_angle() {
     // getting -1 | 1 to the up or bottom then random angle between 45/95 degree
@@ -160,18 +213,56 @@ Vector2 random_angle() {
     return result;
 }
 
+// fresh paddle for a new match - arena goals and a pending smash stay in the arena
+void reset_paddle(Paddle *paddle) {
+    paddle->score = 0;
+    paddle->smash = false;
+    paddle->corner_hit = false;
+    paddle->velocity = Vector2Zero();
+    paddle->position = paddle->orig_pos;
+    paddle->rec = (Rectangle){paddle->position.x,paddle->position.y,paddle->paddle_width,paddle->paddle_height};
+    paddle->helper.position = paddle->position;
+    paddle->helper.rec = paddle->rec;
+}
+
 int generate_rand() {
     int x = GetRandomValue(0,1);
     int y = GetRandomValue(0,1);
     return ((x << 1) ^ y) == 0;
 }
 
+#if !defined(PONG_HEADLESS)
 int main() {
     SetRandomSeed(time(NULL));
     SetWindowState(FLAG_VSYNC_HINT);
     InitWindow(_WINDOW_W,_WINDOW_H,"PONG - Smash!");
     InitAudioDevice();
 
+    Context ctx = {0};
+    InitGame(&ctx);
+
+    //void (*Update)(Screen*, GameScreen*, Board*, Paddle*, Paddle*, Ball*) = {UpdateDrawFrame};
+
+    #if defined(PLATFORM_WEB)
+        emscripten_set_visibilitychange_callback(&ctx, 1, on_visibility_change);
+        emscripten_set_main_loop_arg((void *)UpdateWeb, &ctx, 0, 1);
+    #else
+    SetWindowPosition(0,0);
+    SetTargetFPS(60);
+
+    while (!WindowShouldClose()) {
+        UpdateDrawFrame(&ctx.screen, &ctx.current_screen, &ctx.board, &ctx.human,&ctx.computer,&ctx.ball,&ctx.arena);
+    }
+    #endif
+    UnloadGame(&ctx);
+    CloseAudioDevice();
+    CloseWindow();
+    return 0;
+}
+#endif
+
+// everything after the window and audio device are up - shared with the headless tools
+void InitGame(Context *ctx) {
     // Screen
     Screen screen = {0};
     screen.canvas_width = GetScreenWidth();
@@ -200,6 +291,10 @@ int main() {
     board.shadow_color = GetColor(0x0000FF24);
     board.human_score_text = (Vector2){(screen.canvas_width/2.0f)+18,28.0f};
     board.computer_score_text = (Vector2){(screen.canvas_width/2.0f)-((MeasureTextEx(board.font,"À 99999",board.font_size,0).x)+18),28.0f};
+    board.telemetry = &telemetry;
+    if (getenv("PONG_TELEMETRY") && !telemetry_open(&telemetry,getenv("PONG_TELEMETRY"))) {
+        printf("TELEMETRY: unable to open %s\n",getenv("PONG_TELEMETRY"));
+    }
     // Ball
     Ball ball = {0};
     ball.reset = false;
@@ -243,63 +338,256 @@ int main() {
     computer.helper.position = computer.position;
     computer.helper.rec = human.rec;
     computer.helper.color = GetColor(0xC724B121);
+    // Arena - chaos mode, paddles 0/1 are human/computer, 2/3 are blockers in the middle
+    Arena arena = {0};
+    Rectangle field = {0,board.wall_w,screen.canvas_width,screen.canvas_height-(board.wall_w*2)};
+    if (!arena_init(&arena,ARENA_MAX_BALLS,field,ball.radius,ball.min_speed,GetRandomValue(1,1<<30))) {
+        printf("ARENA: unable to allocate %i balls\n",ARENA_MAX_BALLS);
+    }
+    arena.paddle_count = 4;
+    // Rules - shared by move_ball / move_*_paddle and the lookahead rollouts
+    board.rules = (Rules){
+        .width = screen.canvas_width, .height = screen.canvas_height, .wall_w = board.wall_w, .font_size = board.font_size, .radius = ball.radius,
+        .paddle_w = computer.paddle_width, .paddle_h = computer.paddle_height, .paddle_speed = computer.speed, .paddle_max_speed = computer.max_speed,
+        .human_home_x = human.orig_pos.x, .computer_home_x = computer.orig_pos.x, .computer_home_y = computer.orig_pos.y,
+        .min_speed = ball.min_speed, .max_speed = ball.max_speed,
+    };
+    float budget = getenv("PONG_AI_BUDGET_US") ? (float)atof(getenv("PONG_AI_BUDGET_US")) : 0;
+    lookahead_init(&lookahead,board.rules,(budget > 0) ? budget : LOOKAHEAD_BUDGET_US,GetRandomValue(1,1<<30));
+    board.lookahead = (budget > 0) ? &lookahead : NULL;
     // screen shader
     float screen_size[2] = {screen.canvas_width,screen.canvas_height};
     SetShaderValue(screen.shader, GetShaderLocation(screen.shader, "resolution"), &screen_size, SHADER_UNIFORM_VEC2);
     screen.time = GetShaderLocation(screen.shader, "time");
     screen.time_value = 0;
+    screen.on_demand = !(getenv("PONG_ON_DEMAND") && atoi(getenv("PONG_ON_DEMAND")) == 0);
 
     GameScreen current_screen = LOGO;
 
-    Context ctx = {0};
-    ctx.screen = screen;
-    ctx.current_screen = current_screen;
-    ctx.board = board;
-    ctx.human = human;
-    ctx.computer = computer;
-    ctx.ball = ball;
+    ctx->screen = screen;
+    ctx->current_screen = current_screen;
+    ctx->board = board;
+    ctx->human = human;
+    ctx->computer = computer;
+    ctx->ball = ball;
+    ctx->arena = arena;
+}
 
-    //void (*Update)(Screen*, GameScreen*, Board*, Paddle*, Paddle*, Ball*) = {UpdateDrawFrame};
+void UnloadGame(Context *ctx) {
+    arena_free(&ctx->arena);
+    telemetry_close(ctx->board.telemetry);
+    UnloadRenderTexture(ctx->screen.target);
+    UnloadShader(ctx->screen.shader);
+    UnloadTexture(ctx->screen.logo_raylib);
+    UnloadFont(ctx->board.font);
+    StopSoundMulti();
+    UnloadSound(ctx->board.sfx.logo_intro);
+    UnloadSound(ctx->board.sfx.logo_intro_final);
+    UnloadSound(ctx->board.sfx.start);
+    UnloadSound(ctx->board.sfx.count);
+    UnloadSound(ctx->board.sfx.count_last);
+    UnloadSound(ctx->board.sfx.hit_wall);
+    UnloadSound(ctx->board.sfx.hit_paddle);
+    UnloadSound(ctx->board.sfx.hit_paddle_smash);
+    UnloadSound(ctx->board.sfx.hit_paddle_smash_back);
+    UnloadSound(ctx->board.sfx.reset);
+}
 
+// web main loop - emscripten
+void UpdateWeb(Context *arg) {
+    UpdateDrawFrame(&arg->screen,&arg->current_screen,&arg->board,&arg->human,&arg->computer,&arg->ball,&arg->arena);
+}
+
+#if defined(PLATFORM_WEB)
+// hidden tab - stop the loop, sounds already playing finish on their own
+EM_BOOL on_visibility_change(int type, const EmscriptenVisibilityChangeEvent *event, void *data) {
+    Context *ctx = data;
+    // the page may never come back, main never returns to close the telemetry
+    if (event->hidden) telemetry_flush(ctx->board.telemetry, true);
+    if (ctx->screen.on_demand) {
+        if (event->hidden) {
+            emscripten_pause_main_loop();
+        } else {
+            ctx->screen.resume = true;
+            emscripten_resume_main_loop();
+        }
+    }
+    return 0;
+}
+#endif
+
+bool window_hidden(void) {
     #if defined(PLATFORM_WEB)
-        emscripten_set_main_loop_arg((void *)UpdateWeb, &ctx, 0, 1);
+        return false; // the visibility callback pauses the loop instead
     #else
-    SetWindowPosition(0,0);
-    SetTargetFPS(60);
+        return IsWindowHidden() || IsWindowMinimized();
+    #endif
+}
 
-    while (!WindowShouldClose()) {
-        UpdateDrawFrame(&screen, &current_screen, &board, &human,&computer,&ball);
+// rules time step - a catch-up tick stands for one 60 Hz tick, not the whole idle frame
+float frame_time(Screen *screen) {
+    return screen->catchup ? 1.0f/TICK_RATE : GetFrameTime();
+}
+
+// key edge of this frame - only its first tick sees it, catch-up ticks would replay it
+bool key_pressed(Screen *screen, int key) {
+    if (screen->tick > 0) return false;
+    if (IsKeyPressed(key)) return true;
+    for (int i=0; i<screen->key_count; i++) if (screen->keys[i] == key) return true;
+    return false;
+}
+
+void set_frame_rate(Screen *screen) {
+    int fps = screen->hidden ? HIDDEN_FPS : (screen->idle ? IDLE_FPS : TICK_RATE);
+    #if defined(PLATFORM_WEB)
+        // active frames ride requestAnimationFrame at whatever rate the display runs,
+        // slow ones a timer - every nth animation frame is only 1/fps on a 60 Hz display
+        if (fps == TICK_RATE) emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+        else emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, 1000/fps);
+    #else
+        SetTargetFPS(fps);
+    #endif
+}
+
+void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, Paddle *human, Paddle *computer, Ball *ball, Arena *arena) {
+    screen->stats.frames++;
+    // a press and release between two polls never shows in IsKeyPressed, the key queue keeps it
+    screen->key_count = 0;
+    for (int key=GetKeyPressed(); key > 0; key=GetKeyPressed()) {
+        if (screen->key_count < MAX_QUEUED_KEYS) screen->keys[screen->key_count++] = key;
+    }
+    if (!screen->on_demand) {
+        UpdateFrame(screen, current_screen, board, human, computer, ball, arena);
+        screen->stats.ticks++;
+        DrawFrame(screen, current_screen, board, human, computer, ball, arena, true, true);
+        return;
     }
+    // hidden - game paused, keep polling events at a crawl
+    bool hidden = window_hidden();
+    if (hidden != screen->hidden) {
+        screen->hidden = hidden;
+        screen->resume = !hidden;
+        set_frame_rate(screen);
+    }
+    if (hidden) {
+        DrawFrame(screen, current_screen, board, human, computer, ball, arena, false, false);
+        return;
+    }
+    int ticks = 1;
+    if (screen->resume) {
+        // first frame back from hidden carries the whole pause in its frame time
+        ticks = 0;
+        screen->resume = false;
+        screen->scene_valid = false;
+    } else if (screen->idle) {
+        // idle frames come slower, run the 60 Hz ticks that passed so frame counted timers keep time
+        screen->tick_debt += Clamp(GetFrameTime(),0,1)*TICK_RATE;
+        ticks = (int)screen->tick_debt;
+        screen->tick_debt -= ticks;
+        if (ticks > MAX_CATCHUP_TICKS) ticks = MAX_CATCHUP_TICKS;
+        screen->catchup = true;
+    }
+    for (int i=0; i<ticks; i++) {
+        screen->tick = i;
+        UpdateFrame(screen, current_screen, board, human, computer, ball, arena);
+    }
+    screen->tick = 0;
+    screen->catchup = false;
+    screen->stats.ticks += ticks;
+
+    unsigned long long key = scene_key(*current_screen, board, human, computer, ball, arena);
+    bool changed = !screen->scene_valid || key != screen->scene_key;
+    screen->scene_key = key;
+    screen->scene_valid = true;
+    // idle once the picture sits still, stays idle through a blink but not an animation
+    bool idle = screen->idle;
+    screen->still_frames = changed ? 0 : screen->still_frames + 1;
+    if (!idle && screen->still_frames >= IDLE_AFTER_FRAMES) idle = true;
+    // a key wakes it right away, the next poll is a full idle frame away
+    if (idle && ((changed && screen->changed) || screen->key_count > 0)) idle = false;
+    screen->changed = changed;
+    if (idle != screen->idle) {
+        screen->idle = idle;
+        screen->tick_debt = 0;
+        set_frame_rate(screen);
+    }
+    // an idle picture freezes the crt animation too - nothing moved, nothing to present
+    // on web the canvas keeps the last frame, a desktop swap chain has to be fed every frame
+    #if defined(PLATFORM_WEB) || defined(PONG_HEADLESS)
+        bool present = changed || !screen->idle;
+    #else
+        bool present = true;
     #endif
-    UnloadRenderTexture(screen.target);
-    UnloadShader(screen.shader);
-    UnloadFont(board.font);
-    StopSoundMulti();
-    UnloadSound(board.sfx.logo_intro);
-    UnloadSound(board.sfx.logo_intro_final);
-    UnloadSound(board.sfx.start);
-    UnloadSound(board.sfx.count);
-    UnloadSound(board.sfx.count_last);
-    UnloadSound(board.sfx.hit_wall);
-    UnloadSound(board.sfx.hit_paddle);
-    UnloadSound(board.sfx.hit_paddle_smash);
-    UnloadSound(board.sfx.hit_paddle_smash_back);
-    UnloadSound(board.sfx.reset);
-    CloseAudioDevice();
-    CloseWindow();
-    return 0;
+    DrawFrame(screen, current_screen, board, human, computer, ball, arena, changed, present);
 }
 
-// web main loop - emscripten
-void UpdateWeb(Context *arg) {
-    UpdateDrawFrame(&arg->screen,&arg->current_screen,&arg->board,&arg->human,&arg->computer,&arg->ball);
+// FNV-1a
+unsigned long long hash_bytes(unsigned long long hash, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    for (size_t i=0; i<size; i++) hash = (hash ^ bytes[i]) * 1099511628211ull;
+    return hash;
+}
+#define HASH(hash, value) hash_bytes((hash), &(value), sizeof(value))
+
+// everything the draw_* functions read for the current screen - same key, same picture
+unsigned long long scene_key(GameScreen current_screen, Board *board, Paddle *human, Paddle *computer, Ball *ball, Arena *arena) {
+    unsigned long long hash = HASH(14695981039346656037ull, current_screen);
+    struct Timer *timer = &board->timer;
+    switch(current_screen) {
+        case LOGO:
+            {
+                int phase = timer->frame_counter < 60 ? timer->frame_counter : 60;
+                hash = HASH(hash, phase);
+            }break;
+        case TITLE:
+            {
+                int phase = board->blink ? 2 + (timer->frame_counter/6)%2 : (timer->frame_counter/30)%2;
+                bool hard = board->lookahead != NULL;
+                hash = HASH(hash, phase);
+                hash = HASH(hash, hard);
+            }break;
+        case ENDING: break;
+        default:
+            {
+                bool ball_visible = ((timer->blink_timer/10)%2) || timer->blink_timer <= 1;
+                hash = HASH(hash, board->ai_status);
+                hash = HASH(hash, human->enable_ai);
+                hash = HASH(hash, human->score);
+                hash = HASH(hash, human->position);
+                hash = HASH(hash, human->helper.rec);
+                hash = HASH(hash, human->smash);
+                hash = HASH(hash, computer->score);
+                hash = HASH(hash, computer->position);
+                hash = HASH(hash, computer->helper.rec);
+                hash = HASH(hash, computer->smash);
+                hash = HASH(hash, ball->position);
+                hash = HASH(hash, ball_visible);
+                if (current_screen == START) {
+                    hash = HASH(hash, timer->frame_counter);
+                    hash = HASH(hash, timer->current_frame);
+                }
+                if (current_screen == ARENA) {
+                    hash = hash_bytes(hash, arena->paddles, sizeof(Rectangle)*arena->paddle_count);
+                    hash = hash_bytes(hash, arena->pos_x, sizeof(float)*arena->count);
+                    hash = hash_bytes(hash, arena->pos_y, sizeof(float)*arena->count);
+                }
+            }break;
+    }
+    hash = HASH(hash, board->debug);
+    if (board->debug) {
+        hash = HASH(hash, lookahead.stats.last_rollouts);
+        hash = HASH(hash, lookahead.stats.overruns);
+        hash = HASH(hash, lookahead.stats.worst_us);
+    }
+    return hash;
 }
 
-void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, Paddle *human, Paddle *computer, Ball *ball) {
-    screen->time_value = (float)GetTime();
-    SetShaderValue(screen->shader,screen->time,&screen->time_value, SHADER_UNIFORM_FLOAT);
+// game rules only - no drawing, the headless tools step this directly
+void UpdateFrame(Screen *screen, GameScreen *current_screen, Board *board, Paddle *human, Paddle *computer, Ball *ball, Arena *arena) {
+    telemetry_tick(board->telemetry);
+    // search stats overlay
+    if (key_pressed(screen, KEY_F3)) board->debug = !board->debug;
 
-    // UPDATE
     switch(*current_screen) {
         case LOGO:
             {
@@ -307,7 +595,7 @@ void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, P
                 if (board->timer.frame_counter == 1) {
                     PlaySound(board->sfx.logo_intro);
                 }
-                if (IsKeyPressed(KEY_SPACE) && board->timer.frame_counter > 1) {
+                if (key_pressed(screen, KEY_SPACE) && board->timer.frame_counter > 1) {
                     board->timer.frame_counter = 80;
                     screen->skip_intro = true;
                 }
@@ -327,10 +615,21 @@ void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, P
         case TITLE:
             {
                 board->timer.frame_counter++;
-                if (!board->blink && (IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_ENTER))) {
+                if (!board->blink && (key_pressed(screen, KEY_SPACE) || key_pressed(screen, KEY_ENTER))) {
+                    PlaySound(board->sfx.start);
+                    board->blink = true;
+                }
+                // arena - chaos mode with many balls
+                if (!board->blink && key_pressed(screen, KEY_A) && arena->capacity > 0) {
                     PlaySound(board->sfx.start);
+                    board->arena_mode = true;
                     board->blink = true;
                 }
+                // hard - the computer plays the lookahead
+                if (!board->blink && key_pressed(screen, KEY_H)) {
+                    board->lookahead = board->lookahead ? NULL : &lookahead;
+                    lookahead_reset(&lookahead);
+                }
                 if (board->blink) {
                     board->timer.current_frame--;
                 }
@@ -355,6 +654,13 @@ void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, P
                     board->timer.frame_counter = 0;
                     board->timer.current_frame = 3;
                     *current_screen = GAMEPLAY;
+                    if (board->arena_mode) {
+                        reset_paddle(human);
+                        reset_paddle(computer);
+                        arena_clear(arena);
+                        for (int i=0; i<ARENA_START_BALLS; i++) arena_spawn(arena,ball->position,Vector2Zero());
+                        *current_screen = ARENA;
+                    }
                 }
             }break;
         case GAMEPLAY:
@@ -369,6 +675,10 @@ void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, P
                 //    screen->camera.zoom += 0.6f;
                 //}
                 // !code order necessary
+                if (board->lookahead) {
+                    RulesState state = capture_state(ball, human, computer);
+                    lookahead_update(board->lookahead, &state, frame_time(screen));
+                }
                 ball->position = move_ball(screen, board, ball,human,computer);
                 if (board->ai_status) board->timer.frame_counter++;
                 if ((board->timer.frame_counter/30)%2) {
@@ -380,6 +690,7 @@ void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, P
 
                 if (ball->position.x < 0 ) {
                     PlaySound(board->sfx.reset);
+                    record_event(board, TELEMETRY_POINT, TELEMETRY_HUMAN, ball_state(ball));
                     human->score += 10;
                     human->score = Clamp(human->score,0,MAX_SCORE);
                     ball->direction.x = -fabs(random_angle().x);
@@ -391,6 +702,7 @@ void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, P
                 }
                 if (ball->position.x > screen->canvas_width ) {
                     PlaySound(board->sfx.reset);
+                    record_event(board, TELEMETRY_POINT, TELEMETRY_COMPUTER, ball_state(ball));
                     computer->score += 10;
                     computer->score = Clamp(computer->score,0,MAX_SCORE);
                     ball->direction.x = fabs(random_angle().x);
@@ -421,82 +733,190 @@ void UpdateDrawFrame(Screen *screen, GameScreen *current_screen, Board *board, P
                     computer->corner_hit = false;
                     human->smash = false;
                     computer->smash = false;
+                    // new rally, new search
+                    if (board->lookahead) lookahead_reset(board->lookahead);
                     *current_screen = GAMEPLAY;
                 }
             }break;
         case ENDING:
             {printf("ENDING SCREEN\n");}break;
+        case ARENA:
+            {
+                // paddle ai follows the closest ball coming at it
+                Ball target = *ball;
+                int h = arena_nearest_incoming(arena,human->position.x,1);
+                int c = arena_nearest_incoming(arena,computer->position.x,-1);
+                target.position = (h < 0) ? ball->position : (Vector2){arena->pos_x[h],arena->pos_y[h]};
+                target.velocity = (h < 0) ? Vector2Zero() : (Vector2){arena->vel_x[h]/arena->speed,arena->vel_y[h]/arena->speed};
+                human->position = move_human_paddle(screen, board, human, &target);
+                target.position = (c < 0) ? ball->position : (Vector2){arena->pos_x[c],arena->pos_y[c]};
+                target.velocity = (c < 0) ? Vector2Zero() : (Vector2){arena->vel_x[c]/arena->speed,arena->vel_y[c]/arena->speed};
+                computer->position = move_computer_paddle(screen, board, computer, &target);
+                if (board->ai_status) board->timer.frame_counter++;
+                if ((board->timer.frame_counter/30)%2) {
+                    board->timer.frame_counter = 0;
+                    board->ai_status = false;
+                }
+                // blockers sweep up and down the middle line
+                float sweep = sinf(GetTime()*1.5f) * (screen->canvas_height/4.0f);
+                arena->paddles[0] = human->rec;
+                arena->paddles[1] = computer->rec;
+                arena->paddles[2] = (Rectangle){(screen->canvas_width-human->paddle_width)/2.0f,screen->canvas_height/4.0f-human->paddle_height/2.0f+sweep/2.0f,human->paddle_width,human->paddle_height};
+                arena->paddles[3] = (Rectangle){(screen->canvas_width-human->paddle_width)/2.0f,screen->canvas_height*0.75f-human->paddle_height/2.0f-sweep/2.0f,human->paddle_width,human->paddle_height};
+                arena_step(arena, frame_time(screen));
+                int *sfx = board->timer.arena_sfx;
+                for (int k=0; k<3; k++) if (sfx[k] > 0) sfx[k]--;
+                if (arena->stats.paddle_hits > 0 && sfx[0] == 0) {
+                    PlaySoundMulti(board->sfx.hit_paddle);
+                    sfx[0] = ARENA_SFX_FRAMES;
+                }
+                if (arena->stats.wall_hits > 0 && sfx[1] == 0) {
+                    PlaySound(board->sfx.hit_wall);
+                    sfx[1] = ARENA_SFX_FRAMES;
+                }
+                if (arena->stats.goals[ARENA_SIDE_LEFT] + arena->stats.goals[ARENA_SIDE_RIGHT] > 0 && sfx[2] == 0) {
+                    PlaySound(board->sfx.reset);
+                    sfx[2] = ARENA_SFX_FRAMES;
+                }
+                human->score = Clamp(human->score + arena->stats.goals[ARENA_SIDE_LEFT]*10,0,MAX_SCORE);
+                computer->score = Clamp(computer->score + arena->stats.goals[ARENA_SIDE_RIGHT]*10,0,MAX_SCORE);
+                board->timer.blink_timer++;
+                if ((board->timer.blink_timer % ARENA_SPAWN_FRAMES) == 0) arena_spawn(arena,ball->position,Vector2Zero());
+                // back to title
+                if (key_pressed(screen, KEY_A)) {
+                    arena_clear(arena);
+                    reset_paddle(human);
+                    reset_paddle(computer);
+                    board->arena_mode = false;
+                    board->timer.blink_timer = 0;
+                    board->timer.frame_counter = 0;
+                    *current_screen = TITLE;
+                }
+            }break;
         default: break;
     }
-    // DRAW
-    BeginTextureMode(screen->target);
-        ClearBackground(DARKGRAY);
-        //DrawFPS(40,40);
-        switch(*current_screen) {
-            case LOGO:
-                {
-                    draw_logo(screen,board);
-                }break;
-            case TITLE:
-                {
-                    draw_title(screen,board);
-                }break;
-            case START:
-                {
-                    draw_board(screen,board);
-                    draw_score(board,human,computer);
-                    draw_human_paddle(board,human);
-                    draw_computer_paddle(board,computer);
-                    float x = floor((board->font_size+board->timer.frame_counter)/2.0f)-10;
-                    float y = floor((board->font_size+board->timer.frame_counter)/2.0f)+10;
-                    Vector2 pos = {(screen->canvas_width/2.0f)-x, screen->canvas_height/2.0f-y};
-                    DrawRectangle(pos.x,pos.y,board->font_size+board->timer.frame_counter,board->font_size+board->timer.frame_counter,DARKGRAY);
-                    DrawTextEx(board->font, TextFormat("%i",board->timer.current_frame),pos,board->font_size+board->timer.frame_counter,0,LIGHTGRAY);
-                }break;
-            case GAMEPLAY:
-                {
-                    draw_board(screen, board);
-                    // INFO --> AI Status
-                    draw_ai_status(board, human);
-                    draw_smash_status(screen,board,human,computer);
-                    // human
-                    draw_human_paddle(board, human);
-                    // comp
-                    draw_computer_paddle(board, computer);
-                    // ball
-                    draw_ball(board, ball);
-                    draw_score(board, human, computer);
-                }break;
-            case RESET:
-                {
-                    draw_board(screen, board);
-                    draw_ai_status(board, human);
-                    draw_human_paddle(board, human);
-                    draw_computer_paddle(board, computer);
-                    draw_score(board, human, computer);
-                    draw_ball(board, ball);
-                }break;
-            case ENDING:
-                {printf("ENDING SCREEN\n");}break;
-            default: break;
-        }
-    EndTextureMode();
+}
+
+// scene - redraw the render texture, present - crt pass to the window
+// begin/end drawing always run, they poll input and pace the frame
+void DrawFrame(Screen *screen, GameScreen *current_screen, Board *board, Paddle *human, Paddle *computer, Ball *ball, Arena *arena, bool scene, bool present) {
+    if (!screen->idle) {
+        screen->time_value = (float)GetTime();
+        SetShaderValue(screen->shader,screen->time,&screen->time_value, SHADER_UNIFORM_FLOAT);
+    }
+
+    if (scene) {
+        screen->stats.scenes++;
+        BeginTextureMode(screen->target);
+            ClearBackground(DARKGRAY);
+            //DrawFPS(40,40);
+            switch(*current_screen) {
+                case LOGO:
+                    {
+                        draw_logo(screen,board);
+                    }break;
+                case TITLE:
+                    {
+                        draw_title(screen,board);
+                    }break;
+                case START:
+                    {
+                        draw_board(screen,board);
+                        draw_score(board,human,computer);
+                        draw_human_paddle(board,human);
+                        draw_computer_paddle(board,computer);
+                        float x = floor((board->font_size+board->timer.frame_counter)/2.0f)-10;
+                        float y = floor((board->font_size+board->timer.frame_counter)/2.0f)+10;
+                        Vector2 pos = {(screen->canvas_width/2.0f)-x, screen->canvas_height/2.0f-y};
+                        DrawRectangle(pos.x,pos.y,board->font_size+board->timer.frame_counter,board->font_size+board->timer.frame_counter,DARKGRAY);
+                        DrawTextEx(board->font, TextFormat("%i",board->timer.current_frame),pos,board->font_size+board->timer.frame_counter,0,LIGHTGRAY);
+                    }break;
+                case GAMEPLAY:
+                    {
+                        draw_board(screen, board);
+                        // INFO --> AI Status
+                        draw_ai_status(board, human);
+                        draw_smash_status(screen,board,human,computer);
+                        // human
+                        draw_human_paddle(board, human);
+                        // comp
+                        draw_computer_paddle(board, computer);
+                        // ball
+                        draw_ball(board, ball);
+                        draw_score(board, human, computer);
+                    }break;
+                case RESET:
+                    {
+                        draw_board(screen, board);
+                        draw_ai_status(board, human);
+                        draw_human_paddle(board, human);
+                        draw_computer_paddle(board, computer);
+                        draw_score(board, human, computer);
+                        draw_ball(board, ball);
+                    }break;
+                case ENDING:
+                    {printf("ENDING SCREEN\n");}break;
+                case ARENA:
+                    {
+                        draw_board(screen, board);
+                        draw_ai_status(board, human);
+                        draw_human_paddle(board, human);
+                        draw_computer_paddle(board, computer);
+                        draw_arena(board, arena);
+                        draw_score(board, human, computer);
+                    }break;
+                default: break;
+            }
+            if (board->debug) draw_debug(screen, board);
+        EndTextureMode();
+    }
 
     BeginDrawing();
+    if (present) {
+        screen->stats.presents++;
         ClearBackground(BLACK);
         BeginMode2D(screen->camera);
             BeginShaderMode(screen->shader);
                 DrawTexturePro(screen->target.texture,screen->source,screen->dest,Vector2Zero(),0,WHITE);
             EndShaderMode();
         EndMode2D();
+    }
     EndDrawing();
+    // frame is out - write any full telemetry block now
+    telemetry_flush(board->telemetry, false);
 }
 
 // UPDATE
+// game side of the shared rules - raylib's random stream, sounds and telemetry
+int hook_random(void *data, int min, int max) {
+    (void)data;
+    return GetRandomValue(min,max);
+}
+
+bool hook_smash(void *data, TelemetrySide side) {
+    Board *board = data;
+    // computer smash is searched when the lookahead is on
+    if (side == TELEMETRY_COMPUTER && board->lookahead) return lookahead_smash(board->lookahead);
+    return generate_rand();
+}
+
+void hook_hit(void *data, TelemetrySide side, TelemetryEvent hit, TelemetryEvent smash, const RulesState *state) {
+    Board *board = data;
+    if (smash == TELEMETRY_SMASH) PlaySoundMulti(board->sfx.hit_paddle_smash);
+    else if (smash == TELEMETRY_SMASH_BACK) PlaySoundMulti(board->sfx.hit_paddle_smash_back);
+    else PlaySoundMulti(board->sfx.hit_paddle);
+    // after the bounce so angle and speed are the outgoing ones
+    if (smash != TELEMETRY_EVENT_COUNT) record_event(board, smash, side, state->ball);
+    record_event(board, hit, side, state->ball);
+}
+
+void hook_wall(void *data, const RulesState *state) {
+    Board *board = data;
+    PlaySound(board->sfx.hit_wall);
+    record_event(board, TELEMETRY_WALL_HIT, TELEMETRY_NONE, state->ball);
+}
+
 Vector2 move_ball(Screen *screen, Board *board, Ball *ball, Paddle *human, Paddle *computer) {
-    ball->position.x += (ball->velocity.x * GetFrameTime() * (ball->speed * ball->smash_speed)) * ball->corner_speed;
-    ball->position.y += (ball->velocity.y * GetFrameTime() * (ball->speed * ball->smash_speed)) * ball->corner_speed;
-    ball->speed = Clamp(ball->speed,ball->min_speed,ball->max_speed);
     // DEBUG
     //if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
     //    ball->position = GetMousePosition();
@@ -509,102 +929,50 @@ Vector2 move_ball(Screen *screen, Board *board, Ball *ball, Paddle *human, Paddl
 
     //    }
     //}
+    RulesState state = capture_state(ball, human, computer);
+    RulesHooks hooks = {board, hook_random, hook_smash, hook_hit, hook_wall};
+    rules_move_ball(&board->rules, &state, frame_time(screen), &hooks);
+    ball->position = state.ball.position;
+    ball->velocity = state.ball.velocity;
+    ball->speed = state.ball.speed;
+    ball->smash_speed = state.ball.smash_speed;
+    ball->corner_speed = state.ball.corner_speed;
+    human->position = state.human.position;
+    human->smash = state.human.smash;
+    human->corner_hit = state.human.corner_hit;
+    human->score = state.human.score;
+    computer->position = state.computer.position;
+    computer->smash = state.computer.smash;
+    computer->corner_hit = state.computer.corner_hit;
+    computer->score = state.computer.score;
+    return ball->position;
+}
 
-    // human
-    if (CheckCollisionCircleRec(ball->position,ball->radius,human->rec)) {
-        ball->speed *= 1.03f; /* slowly increasing ball speed */
-        if (!human->corner_hit) {
-            human->score++;
-            human->position.x += 6.0f; /* knokback */
-        } 
-        // smash
-        if (human->enable_ai && generate_rand()) human->smash = true;
-        if (human->smash && !computer->smash) {
-            PlaySoundMulti(board->sfx.hit_paddle_smash);
-            ball->smash_speed = GetRandomValue(35,45) * (PI/180) * 2.1f;
-            computer->smash = false;
-        } else if (computer->smash && ball->smash_speed > 1.0f) {
-            // hit back smash hit comes from computer
-            PlaySoundMulti(board->sfx.hit_paddle_smash_back);
-            human->score += 3; /* total 4 */
-            ball->smash_speed = GetRandomValue(25,35) * (PI/180) * 1.6;
-            computer->smash = false;
-        } else {
-            PlaySoundMulti(board->sfx.hit_paddle);
-            ball->smash_speed = 1.0f;
-        }
+RulesBall ball_state(Ball *ball) {
+    RulesBall result = {ball->position, ball->velocity, ball->speed, ball->smash_speed, ball->corner_speed};
+    return result;
+}
 
-        float a = (human->position.y+(human->paddle_height/2.0f)) - (ball->position.y - ball->radius/2.0f);
-        float b = (a/(human->paddle_height/2.0f));
-        float c = (b * (45*PI/180));
-        if (ball->position.x > human->position.x) {
-            human->corner_hit = true;
-            ball->corner_speed = 3.0f;
-            if (ball->position.y < human->position.y + human->paddle_height/2.0f) {
-                ball->velocity = (Vector2){0.3,-0.3};
-            } else {ball->velocity = (Vector2){0.3,0.3};}
-        } else {
-            ball->velocity.x = -cos(c);
-            ball->velocity.y = -sin(c);
-        }
-    }
+RulesPaddle paddle_state(Paddle *paddle) {
+    RulesPaddle result = {paddle->position, paddle->velocity.y, paddle->smash, paddle->corner_hit, paddle->score};
+    return result;
+}
 
-    // computer
-    if (CheckCollisionCircleRec(ball->position,ball->radius,computer->rec)) {
-        ball->speed *= 1.03f; /* slowly incr ball spd */
-        if (!computer->corner_hit) {
-            computer->score++;
-            computer->position.x -= 6.0f; /* knockback */
-        }
-        // smash
-        if (generate_rand() && !human->smash) {
-            PlaySoundMulti(board->sfx.hit_paddle_smash);
-            ball->smash_speed = GetRandomValue(35,45) * (PI/180) * 2.1f; //1.6f;
-            computer->smash = true;
-        } else if (human->smash && ball->smash_speed > 1.0f) {
-            // hit back smash comes from human
-            PlaySoundMulti(board->sfx.hit_paddle_smash_back);
-            human->score += 3; /* total 4 */
-            ball->smash_speed = GetRandomValue(25,35) * (PI/180) * 1.6f;
-            human->smash = false;
-        } else {
-            PlaySoundMulti(board->sfx.hit_paddle);
-            ball->smash_speed = 1.0f;
-        }
-        // collision logic very challenging here, i've tryed my best
-        float a = (computer->position.y+(computer->paddle_height/2.0f)) - (ball->position.y+ball->radius/2.0f);
-        float b = (a/(computer->paddle_height/2.0f));
-        float c = (b * (45*PI/180) );
-        if (ball->position.x < computer->position.x + computer->paddle_width) {
-            computer->corner_hit = true;
-            ball->corner_speed = 3.0f;
-            if (ball->position.y < computer->position.y + computer->paddle_height/2.0f) {
-                ball->velocity = (Vector2){-0.3,-0.3};
-            } else {ball->velocity = (Vector2){-0.3,0.3};}
-        } else {
-            ball->velocity.x = cos(c);
-            ball->velocity.y = -sin(c);
-        }
-    }
-    if (ball->position.y < board->wall_w+ball->radius) {
-        PlaySound(board->sfx.hit_wall);
-        Vector2 top = (Vector2){board->wall_top.x,board->wall_top.y+board->font_size};
-        Vector2 final_t = Vector2Reflect(ball->velocity,Vector2Normalize(top));
-        ball->velocity.x = final_t.x;
-        ball->velocity.y = fabs(final_t.y);
-    }
-    if (ball->position.y > screen->canvas_height-(board->wall_w+ball->radius)) {
-        PlaySound(board->sfx.hit_wall);
-        Vector2 bottom = (Vector2){board->wall_bottom.x,board->wall_bottom.y};
-        Vector2 final_b = Vector2Reflect(ball->velocity,Vector2Normalize(bottom));
-        ball->velocity.x = final_b.x;
-        ball->velocity.y = -fabs(final_b.y);
-    }
-    return ball->position;
+// the rally as the rules and the lookahead rollouts see it
+RulesState capture_state(Ball *ball, Paddle *human, Paddle *computer) {
+    RulesState state = {ball_state(ball), paddle_state(human), paddle_state(computer), human->enable_ai};
+    return state;
+}
+
+// angle is above the horizon, speed is the real distance per second
+void record_event(Board *board, TelemetryEvent type, TelemetrySide side, RulesBall ball) {
+    float speed = Vector2Length(ball.velocity) * ball.speed * ball.smash_speed * ball.corner_speed;
+    float angle = atan2f(-ball.velocity.y, fabsf(ball.velocity.x));
+    telemetry_record(board->telemetry, type, side, ball.position.x, ball.position.y, angle, speed);
 }
 
 Vector2 move_human_paddle(Screen *screen, Board *board, Paddle *human, Ball *ball) {
-    if (IsKeyPressed(KEY_P) && !board->ai_status) {
+    if (key_pressed(screen, KEY_P) && !board->ai_status) {
         board->ai_status = true;
         human->enable_ai = !human->enable_ai;
     }
@@ -618,32 +986,19 @@ Vector2 move_human_paddle(Screen *screen, Board *board, Paddle *human, Ball *bal
         // TODO : with ai help?
         human->velocity.y = Lerp(human->velocity.y,0,0.8);
     }
-    if (IsKeyPressed(KEY_SPACE) && !human->smash && !human->corner_hit) {
+    if (key_pressed(screen, KEY_SPACE) && !human->smash && !human->corner_hit) {
         human->smash = true;
     }
     if (human->corner_hit) {human->velocity = Vector2Zero();}
+    RulesPaddle paddle = paddle_state(human);
     if (human->enable_ai) {
-        // check if the ball has crossed the line
-        if (!human->corner_hit && ball->velocity.x > 0 && ball->position.x > screen->canvas_width/2.0f ) {
-            // check if the y-position of the ball is not in the middle of the paddle
-            if (ball->position.y != human->position.y + (human->paddle_height/2.0f)) {
-               float timetilcol = ((screen->canvas_width-human->paddle_width)-ball->position.x)/ball->velocity.x;
-               float distancewanted = (human->position.y+(human->paddle_height/2.0f)) - (ball->position.y);
-               float velocitywanted = -distancewanted/timetilcol;
-               if (velocitywanted > human->max_speed) {
-                   // TODO --> rotate ball?
-                   human->velocity.y = human->max_speed;
-               } else if (velocitywanted < -human->max_speed) {
-                   human->velocity.y = -human->max_speed;
-               } else {human->velocity.y = velocitywanted;}
-            } else {human->velocity.y = 0;}
-        } else {human->velocity = Vector2Zero();}
+        RulesBall target = ball_state(ball);
+        paddle.velocity = rules_track(&board->rules, &paddle, &target, TELEMETRY_HUMAN);
     }
     // TODO : ai helper --> beneficial usage also speed?
-    human->velocity.y = Lerp(human->velocity.y,0,0.2);
-    human->position.x = Lerp(human->position.x, human->orig_pos.x,0.2);
-    human->position.y += human->velocity.y * human->speed * GetFrameTime();
-    human->position.y = Clamp(human->position.y,board->font_size+2,screen->canvas_height-(human->paddle_height+board->font_size));
+    rules_move_paddle(&board->rules, &paddle, TELEMETRY_HUMAN, frame_time(screen));
+    human->position = paddle.position;
+    human->velocity.y = paddle.velocity;
     human->helper.position = Vector2Lerp(human->helper.position,human->position,0.3f);
     human->helper.position.x += 3;
     human->rec = (Rectangle){human->position.x,human->position.y,human->paddle_width,human->paddle_height};
@@ -652,24 +1007,17 @@ Vector2 move_human_paddle(Screen *screen, Board *board, Paddle *human, Ball *bal
 }
 
 Vector2 move_computer_paddle(Screen *screen, Board *board, Paddle *computer, Ball *ball) {
-    if (!computer->corner_hit && ball->velocity.x < 0 && ball->position.x < screen->canvas_width/2.0f ) {
-        if (ball->position.y != computer->position.y + (computer->paddle_height/2.0f)) {
-            float timetilcol = ((computer->paddle_width)-ball->position.x)/ball->velocity.x;
-            float distancewanted = (computer->position.y+(computer->paddle_height/2.0f)) - (ball->position.y);
-            float velocitywanted = -distancewanted/timetilcol;
-            if (velocitywanted > computer->max_speed) {
-                computer->velocity.y = computer->max_speed;
-            } else if (velocitywanted < -computer->max_speed) {
-                computer->velocity.y = -computer->max_speed;
-            } else {
-                computer->velocity.y = velocitywanted;
-            }
-        } else { computer->velocity.y = 0; }
-    } else {computer->velocity = Vector2Zero();}
-    computer->position.x = Lerp(computer->position.x, computer->orig_pos.x,0.2);
-    computer->velocity.y = Lerp(computer->velocity.y,0,0.2);
-    computer->position.y += computer->velocity.y * computer->speed * GetFrameTime();
-    computer->position.y = Clamp(computer->position.y,board->font_size+2,screen->canvas_height-(computer->paddle_height+computer->paddle_width));
+    RulesPaddle paddle = paddle_state(computer);
+    if (board->lookahead && !board->arena_mode) {
+        // head for the plan picked by the search
+        paddle.velocity = computer->corner_hit ? 0 : lookahead_steer(computer->position.y, lookahead_target(board->lookahead), computer->speed, computer->max_speed, frame_time(screen));
+    } else {
+        RulesBall target = ball_state(ball);
+        paddle.velocity = rules_track(&board->rules, &paddle, &target, TELEMETRY_COMPUTER);
+    }
+    rules_move_paddle(&board->rules, &paddle, TELEMETRY_COMPUTER, frame_time(screen));
+    computer->position = paddle.position;
+    computer->velocity.y = paddle.velocity;
     computer->helper.position = Vector2Lerp(computer->helper.position,computer->position,0.3f);
     computer->helper.position.x -= 3;
     computer->rec = (Rectangle){computer->position.x,computer->position.y,computer->paddle_width,computer->paddle_height};
@@ -698,6 +1046,8 @@ void draw_title(Screen *screen, Board *board) {
     Vector2 title_pos1 = {(screen->canvas_width/2.0f)-(MeasureText("PONG",86)/2.0f),90};
     Vector2 title_pos2 = {(screen->canvas_width/2.0f)+(MeasureText("SMASH!",26)/2.5f),90+96};
     Vector2 launch_pos = {(screen->canvas_width/2.0f)-(MeasureText("PRESS START",board->font_size)/2.0f),screen->canvas_height/1.5f};
+    const char *ai_text = board->lookahead ? "H - AI HARD" : "H - AI NORMAL";
+    Vector2 ai_pos = {(screen->canvas_width/2.0f)-(MeasureText(ai_text,board->font_size)/2.0f),launch_pos.y+board->font_size*2};
     DrawTextEx(board->font, "PONG",title_pos1,86,0,YELLOW);
     DrawTextEx(board->font, "SMASH!",title_pos2,26,0,MAGENTA);
     DrawLineEx((Vector2){title_pos1.x,title_pos2.y +13},(Vector2){title_pos2.x-12,title_pos2.y + 13},8,WHITE);
@@ -710,6 +1060,7 @@ void draw_title(Screen *screen, Board *board) {
             DrawTextEx(board->font,"PRESS START",launch_pos,board->font_size,0,WHITE);
         }
     }
+    DrawTextEx(board->font,ai_text,ai_pos,board->font_size,0,board->lookahead ? MAGENTA : LIGHTGRAY);
 }
 
 void draw_board(Screen *screen, Board *board) {
@@ -736,6 +1087,16 @@ void draw_ai_status(Board *board, Paddle *human) {
     }
 }
 
+// F3 - what the lookahead costs, the unload print used to tell this
+void draw_debug(Screen *screen, Board *board) {
+    struct LookaheadStats *stats = &lookahead.stats;
+    float y = screen->canvas_height-(board->wall_w+board->font_size*4);
+    float avg = stats->frames ? (float)stats->rollouts/stats->frames : 0;
+    DrawTextEx(board->font, board->lookahead ? TextFormat("AI HARD %.0f US",lookahead.budget_us) : "AI NORMAL", (Vector2){20,y},board->font_size,0,GREEN);
+    DrawTextEx(board->font, TextFormat("ROLLOUTS %i AVG %.1f",stats->last_rollouts,avg), (Vector2){20,y+board->font_size},board->font_size,0,GREEN);
+    DrawTextEx(board->font, TextFormat("OVER %ld/%ld WORST %.0f US",stats->overruns,stats->frames,stats->worst_us), (Vector2){20,y+board->font_size*2},board->font_size,0,GREEN);
+}
+
 void draw_smash_status(Screen *screen, Board *board, Paddle *human, Paddle *computer) {
     if (human->smash | computer->smash) {
         float x = (screen->canvas_width/2.0f) - (MeasureText("SMASH!",board->font_size)/2.0f);
@@ -776,3 +1137,15 @@ void draw_score(Board *board, Paddle *human, Paddle *computer) {
     DrawTextEx(board->font, TextFormat("Ì %05d",human->score),board->human_score_text,board->font_size,0,board->score_text_color);
     DrawTextEx(board->font, TextFormat("Â %05d",computer->score),board->computer_score_text,board->font_size,0,board->score_text_color);
 }
+
+void draw_arena(Board *board, Arena *arena) {
+    for (int p=2; p<arena->paddle_count; p++) {
+        for (int i=0; i<arena->paddles[p].height; i+=20) {
+            DrawTextEx(board->font, "À", (Vector2){arena->paddles[p].x,arena->paddles[p].y+i},board->font_size,0,SKYBLUE);
+        }
+    }
+    for (int i=0; i<arena->count; i++) {
+        Vector2 center = (Vector2){arena->pos_x[i]-arena->radius-4,arena->pos_y[i]-arena->radius};
+        DrawTextEx(board->font, "Æ",center,board->font_size,0,WHITE);
+    }
+}
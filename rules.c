@@ -0,0 +1,154 @@
+/*******************************************************************************************
+*
+*   raylib study [rules.c] - Pong _ match rules shared by the game and the lookahead
+*
+*   Game licensed under MIT.
+*
+********************************************************************************************/
+
+#include <math.h>
+#include "rules.h"
+#include "raymath.h"
+
+// same test as raylib's CheckCollisionCircleRec, centers are truncated the same way
+static bool hits_paddle(Vector2 center, float radius, Vector2 pos, float w, float h) {
+    int rec_cx = (int)(pos.x + w/2.0f);
+    int rec_cy = (int)(pos.y + h/2.0f);
+    float dx = fabsf(center.x - (float)rec_cx);
+    float dy = fabsf(center.y - (float)rec_cy);
+    if (dx > (w/2.0f + radius)) return false;
+    if (dy > (h/2.0f + radius)) return false;
+    if (dx <= (w/2.0f)) return true;
+    if (dy <= (h/2.0f)) return true;
+    float corner = (dx - w/2.0f)*(dx - w/2.0f) + (dy - h/2.0f)*(dy - h/2.0f);
+    return corner <= radius*radius;
+}
+
+TelemetrySide rules_move_ball(const Rules *r, RulesState *s, float dt, const RulesHooks *hooks) {
+    RulesBall *ball = &s->ball;
+    RulesPaddle *human = &s->human, *computer = &s->computer;
+    TelemetrySide touched = TELEMETRY_NONE;
+    ball->position.x += (ball->velocity.x * dt * (ball->speed * ball->smash_speed)) * ball->corner_speed;
+    ball->position.y += (ball->velocity.y * dt * (ball->speed * ball->smash_speed)) * ball->corner_speed;
+    ball->speed = Clamp(ball->speed,r->min_speed,r->max_speed);
+
+    // human
+    if (hits_paddle(ball->position,r->radius,human->position,r->paddle_w,r->paddle_h)) {
+        ball->speed *= 1.03f; /* slowly increasing ball speed */
+        TelemetryEvent smash_event = TELEMETRY_EVENT_COUNT, hit_event = TELEMETRY_PADDLE_HIT;
+        if (!human->corner_hit) {
+            human->score++;
+            human->position.x += 6.0f; /* knokback */
+        }
+        // smash
+        if (s->human_ai && hooks->smash(hooks->data, TELEMETRY_HUMAN)) human->smash = true;
+        if (human->smash && !computer->smash) {
+            smash_event = TELEMETRY_SMASH;
+            ball->smash_speed = hooks->random(hooks->data,35,45) * (PI/180) * 2.1f;
+            computer->smash = false;
+        } else if (computer->smash && ball->smash_speed > 1.0f) {
+            // hit back smash hit comes from computer
+            smash_event = TELEMETRY_SMASH_BACK;
+            human->score += 3; /* total 4 */
+            ball->smash_speed = hooks->random(hooks->data,25,35) * (PI/180) * 1.6;
+            computer->smash = false;
+        } else {
+            ball->smash_speed = 1.0f;
+        }
+
+        float a = (human->position.y+(r->paddle_h/2.0f)) - (ball->position.y - r->radius/2.0f);
+        float b = (a/(r->paddle_h/2.0f));
+        float c = (b * (45*PI/180));
+        if (ball->position.x > human->position.x) {
+            human->corner_hit = true;
+            ball->corner_speed = 3.0f;
+            if (ball->position.y < human->position.y + r->paddle_h/2.0f) {
+                ball->velocity = (Vector2){0.3,-0.3};
+            } else {ball->velocity = (Vector2){0.3,0.3};}
+            hit_event = TELEMETRY_CORNER_HIT;
+        } else {
+            ball->velocity.x = -cos(c);
+            ball->velocity.y = -sin(c);
+        }
+        touched = TELEMETRY_HUMAN;
+        if (hooks->hit) hooks->hit(hooks->data, TELEMETRY_HUMAN, hit_event, smash_event, s);
+    }
+
+    // computer
+    if (hits_paddle(ball->position,r->radius,computer->position,r->paddle_w,r->paddle_h)) {
+        ball->speed *= 1.03f; /* slowly incr ball spd */
+        TelemetryEvent smash_event = TELEMETRY_EVENT_COUNT, hit_event = TELEMETRY_PADDLE_HIT;
+        if (!computer->corner_hit) {
+            computer->score++;
+            computer->position.x -= 6.0f; /* knockback */
+        }
+        bool smash = hooks->smash(hooks->data, TELEMETRY_COMPUTER);
+        if (smash && !human->smash) {
+            smash_event = TELEMETRY_SMASH;
+            ball->smash_speed = hooks->random(hooks->data,35,45) * (PI/180) * 2.1f;
+            computer->smash = true;
+        } else if (human->smash && ball->smash_speed > 1.0f) {
+            // hit back smash comes from human
+            smash_event = TELEMETRY_SMASH_BACK;
+            human->score += 3; /* total 4 */
+            ball->smash_speed = hooks->random(hooks->data,25,35) * (PI/180) * 1.6f;
+            human->smash = false;
+        } else {
+            ball->smash_speed = 1.0f;
+        }
+        float a = (computer->position.y+(r->paddle_h/2.0f)) - (ball->position.y+r->radius/2.0f);
+        float b = (a/(r->paddle_h/2.0f));
+        float c = (b * (45*PI/180) );
+        if (ball->position.x < computer->position.x + r->paddle_w) {
+            computer->corner_hit = true;
+            ball->corner_speed = 3.0f;
+            if (ball->position.y < computer->position.y + r->paddle_h/2.0f) {
+                ball->velocity = (Vector2){-0.3,-0.3};
+            } else {ball->velocity = (Vector2){-0.3,0.3};}
+            hit_event = TELEMETRY_CORNER_HIT;
+        } else {
+            ball->velocity.x = cos(c);
+            ball->velocity.y = -sin(c);
+        }
+        touched = TELEMETRY_COMPUTER;
+        if (hooks->hit) hooks->hit(hooks->data, TELEMETRY_COMPUTER, hit_event, smash_event, s);
+    }
+    if (ball->position.y < r->wall_w+r->radius) {
+        Vector2 top = (Vector2){0,r->font_size};
+        Vector2 final_t = Vector2Reflect(ball->velocity,Vector2Normalize(top));
+        ball->velocity.x = final_t.x;
+        ball->velocity.y = fabs(final_t.y);
+        if (hooks->wall) hooks->wall(hooks->data, s);
+    }
+    if (ball->position.y > r->height-(r->wall_w+r->radius)) {
+        Vector2 bottom = (Vector2){0,r->height-r->wall_w};
+        Vector2 final_b = Vector2Reflect(ball->velocity,Vector2Normalize(bottom));
+        ball->velocity.x = final_b.x;
+        ball->velocity.y = -fabs(final_b.y);
+        if (hooks->wall) hooks->wall(hooks->data, s);
+    }
+    return touched;
+}
+
+float rules_track(const Rules *r, const RulesPaddle *paddle, const RulesBall *ball, TelemetrySide side) {
+    // check if the ball has crossed the line toward this paddle
+    bool coming = (side == TELEMETRY_HUMAN) ? (ball->velocity.x > 0 && ball->position.x > r->width/2.0f)
+                                            : (ball->velocity.x < 0 && ball->position.x < r->width/2.0f);
+    if (paddle->corner_hit || !coming) return 0;
+    // check if the y-position of the ball is not in the middle of the paddle
+    if (ball->position.y == paddle->position.y + (r->paddle_h/2.0f)) return 0;
+    float face = (side == TELEMETRY_HUMAN) ? r->width - r->paddle_w : r->paddle_w;
+    float timetilcol = (face-ball->position.x)/ball->velocity.x;
+    float distancewanted = (paddle->position.y+(r->paddle_h/2.0f)) - (ball->position.y);
+    float velocitywanted = -distancewanted/timetilcol;
+    return Clamp(velocitywanted,-r->paddle_max_speed,r->paddle_max_speed);
+}
+
+void rules_move_paddle(const Rules *r, RulesPaddle *paddle, TelemetrySide side, float dt) {
+    bool human = (side == TELEMETRY_HUMAN);
+    paddle->velocity = Lerp(paddle->velocity,0,0.2);
+    paddle->position.x = Lerp(paddle->position.x,human ? r->human_home_x : r->computer_home_x,0.2);
+    paddle->position.y += paddle->velocity * r->paddle_speed * dt;
+    // the computer stops a paddle width above the bottom, the human a font size
+    paddle->position.y = Clamp(paddle->position.y,r->font_size+2,r->height-(r->paddle_h+(human ? r->font_size : r->paddle_w)));
+}
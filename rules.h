@@ -0,0 +1,64 @@
+/*******************************************************************************************
+*
+*   raylib study [rules.h] - Pong _ match rules shared by the game and the lookahead
+*
+*   One tick of the ball and paddle physics on a plain copy of the rally. main.c copies its
+*   Ball / Paddle in and out around every call, the lookahead rollouts step their own copy.
+*   Everything the two do differently goes through hooks: the random stream, who smashes,
+*   and the sounds / telemetry of a hit. Uses raylib types and raymath only, no raylib calls.
+*
+********************************************************************************************/
+
+#ifndef RULES_H
+#define RULES_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "telemetry.h"
+
+// fixed geometry and tuning, copied from the game once
+typedef struct Rules {
+    float width, height, wall_w, font_size, radius;
+    float paddle_w, paddle_h, paddle_speed, paddle_max_speed;
+    float human_home_x, computer_home_x, computer_home_y;
+    float min_speed, max_speed;
+} Rules;
+
+typedef struct RulesBall {
+    Vector2 position, velocity;
+    float speed, smash_speed, corner_speed;
+} RulesBall;
+
+typedef struct RulesPaddle {
+    Vector2 position;
+    float velocity; /* y only */
+    bool smash, corner_hit;
+    int score;
+} RulesPaddle;
+
+// everything the rules read and write during a rally
+typedef struct RulesState {
+    RulesBall ball;
+    RulesPaddle human, computer;
+    bool human_ai;
+} RulesState;
+
+// random - smash speeds in [min,max], smash - does side smash on this hit (the human only
+// asks while its ai plays), hit / wall - after the bounce, smash is TELEMETRY_EVENT_COUNT
+// on a plain hit. hit and wall may be NULL.
+typedef struct RulesHooks {
+    void *data;
+    int (*random)(void *data, int min, int max);
+    bool (*smash)(void *data, TelemetrySide side);
+    void (*hit)(void *data, TelemetrySide side, TelemetryEvent hit, TelemetryEvent smash, const RulesState *state);
+    void (*wall)(void *data, const RulesState *state);
+} RulesHooks;
+
+// returns the side that touched the ball this tick, TELEMETRY_NONE for none
+TelemetrySide rules_move_ball(const Rules *rules, RulesState *state, float dt, const RulesHooks *hooks);
+// paddle ai velocity toward the ball, 0 while the ball is not coming
+float rules_track(const Rules *rules, const RulesPaddle *paddle, const RulesBall *ball, TelemetrySide side);
+// damps the velocity, moves and clamps the paddle, knockback eases back home
+void rules_move_paddle(const Rules *rules, RulesPaddle *paddle, TelemetrySide side, float dt);
+
+#endif // RULES_H
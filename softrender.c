@@ -0,0 +1,944 @@
+/*******************************************************************************************
+*
+*   raylib study [softrender.c] - Pong _ software render backend
+*
+*   Game licensed under MIT.
+*
+********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <math.h>
+#if defined(__SSE2__) && !defined(SOFT_NO_SIMD)
+    #include <emmintrin.h>
+    #define SOFT_SIMD 1
+#endif
+#include "softrender.h"
+
+// stb comes with raylib - src/external
+#define STB_IMAGE_IMPLEMENTATION
+#include "external/stb_image.h"
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "external/stb_image_write.h"
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "external/stb_truetype.h"
+
+#define SOFT_MAX_WIDTH 4096
+#define SOFT_GLYPH_PADDING 4 /* same as raylib FONT_TTF_DEFAULT_CHARS_PADDING */
+#define SOFT_ATLAS_WIDTH 512
+#define SOFT_POW_LUT 1024
+
+typedef struct SoftTexture {
+    bool used, flipped, bilinear;
+    int width, height;
+    Color *pixels;
+} SoftTexture;
+
+typedef enum SoftShader { SOFT_SHADER_DEFAULT = 0, SOFT_SHADER_CRT } SoftShader;
+
+static struct Soft {
+    int width, height;
+    unsigned int window, target, shader;
+    bool mode2d;
+    Camera2D camera;
+    float resolution[2], time_uniform;
+    SoftTexture textures[SOFT_MAX_TEXTURES];
+    // per pixel tables for the crt pass, rebuilt when the mapping changes
+    struct SoftCrt {
+        int x0, y0, x1, y1, tex_w, tex_h;
+        Rectangle source, dest;
+        float resolution[2];
+        float *gain, *phase_sin, *phase_cos;
+        int *texel;
+        short *texel_x, *texel_y;
+        float pow_lut[SOFT_POW_LUT];
+    } crt;
+} soft;
+
+// clock, keys and random stream are per thread so the rules can be stepped on every core,
+// drawing stays on the thread that opened the window
+static _Thread_local struct SoftPlatform {
+    double time;
+    float frame_time;
+    long frames;
+    unsigned int seed;
+    bool hidden;
+    bool key_down[SOFT_MAX_KEYS], key_pressed[SOFT_MAX_KEYS];
+    int key_queue[SOFT_KEY_QUEUE], key_queue_count;
+} platform = {.frame_time = 1.0f/60.0f, .seed = 0x2545F491u};
+
+static Color row_buffer[SOFT_MAX_WIDTH];
+static float column_u[SOFT_MAX_WIDTH];
+
+// -- textures
+static unsigned int texture_alloc(int width, int height, Color *pixels) {
+    for (unsigned int id=1; id<SOFT_MAX_TEXTURES; id++) {
+        if (soft.textures[id].used) continue;
+        soft.textures[id] = (SoftTexture){true, false, false, width, height, pixels};
+        return id;
+    }
+    free(pixels);
+    return 0;
+}
+
+static SoftTexture *texture_get(unsigned int id) {
+    if (id == 0 || id >= SOFT_MAX_TEXTURES || !soft.textures[id].used) return NULL;
+    return &soft.textures[id];
+}
+
+static void texture_free(unsigned int id) {
+    SoftTexture *tex = texture_get(id);
+    if (!tex) return;
+    free(tex->pixels);
+    memset(tex, 0, sizeof(*tex));
+}
+
+// -- blending, raylib BLEND_ALPHA: src*a + dst*(1 - a) on all four channels
+static inline unsigned char div255(unsigned int x) {
+    x += 128;
+    return (unsigned char)((x + (x >> 8)) >> 8);
+}
+
+static inline Color blend_pixel(Color src, Color dst) {
+    unsigned int a = src.a, ia = 255 - src.a;
+    return (Color){div255(src.r*a + dst.r*ia), div255(src.g*a + dst.g*ia), div255(src.b*a + dst.b*ia), div255(src.a*a + dst.a*ia)};
+}
+
+#if defined(SOFT_SIMD)
+static inline __m128i div255_epi16(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+#endif
+
+static void fill_span(Color *dst, Color color, int n) {
+    int i = 0;
+#if defined(SOFT_SIMD)
+    uint32_t packed;
+    memcpy(&packed, &color, 4);
+    __m128i c = _mm_set1_epi32((int)packed);
+    for (; i + 4 <= n; i += 4) _mm_storeu_si128((__m128i *)(dst + i), c);
+#endif
+    for (; i<n; i++) dst[i] = color;
+}
+
+static void blend_span_solid(Color *dst, Color color, int n) {
+    int i = 0;
+#if defined(SOFT_SIMD)
+    uint32_t packed;
+    memcpy(&packed, &color, 4);
+    __m128i zero = _mm_setzero_si128();
+    __m128i src = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int)packed), zero), _mm_set1_epi16(color.a));
+    __m128i inv = _mm_set1_epi16(255 - color.a);
+    for (; i + 4 <= n; i += 4) {
+        __m128i d = _mm_loadu_si128((__m128i *)(dst + i));
+        __m128i lo = _mm_add_epi16(src, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv));
+        __m128i hi = _mm_add_epi16(src, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(div255_epi16(lo), div255_epi16(hi)));
+    }
+#endif
+    for (; i<n; i++) dst[i] = blend_pixel(color, dst[i]);
+}
+
+static void blend_span(Color *dst, const Color *src, int n) {
+    int i = 0;
+#if defined(SOFT_SIMD)
+    __m128i zero = _mm_setzero_si128();
+    __m128i full = _mm_set1_epi16(255);
+    for (; i + 4 <= n; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        // nothing to do for fully transparent texels - most of a glyph quad
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(s, 24), zero)) == 0xFFFF) continue;
+        __m128i d = _mm_loadu_si128((__m128i *)(dst + i));
+        __m128i s_lo = _mm_unpacklo_epi8(s, zero), s_hi = _mm_unpackhi_epi8(s, zero);
+        __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, 0xFF), 0xFF);
+        __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, 0xFF), 0xFF);
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(s_lo, a_lo), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, a_lo)));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(s_hi, a_hi), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, a_hi)));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(div255_epi16(lo), div255_epi16(hi)));
+    }
+#endif
+    for (; i<n; i++) {
+        if (src[i].a) dst[i] = blend_pixel(src[i], dst[i]);
+    }
+}
+
+// -- rasterizer, pixel centers like GL
+static Vector2 to_target(Vector2 p) {
+    if (!soft.mode2d) return p;
+    return (Vector2){(p.x - soft.camera.target.x)*soft.camera.zoom + soft.camera.offset.x,
+                     (p.y - soft.camera.target.y)*soft.camera.zoom + soft.camera.offset.y};
+}
+
+static bool pixel_span(float from, float to, int limit, int *first, int *last) {
+    *first = (int)ceilf(from - 0.5f);
+    *last = (int)ceilf(to - 0.5f);
+    if (*first < 0) *first = 0;
+    if (*last > limit) *last = limit;
+    return *first < *last;
+}
+
+static void fill_rect(Rectangle rec, Color color) {
+    SoftTexture *target = texture_get(soft.target);
+    if (!target || color.a == 0) return;
+    Vector2 a = to_target((Vector2){rec.x, rec.y});
+    Vector2 b = to_target((Vector2){rec.x + rec.width, rec.y + rec.height});
+    int x0, x1, y0, y1;
+    if (!pixel_span(fminf(a.x, b.x), fmaxf(a.x, b.x), target->width, &x0, &x1)) return;
+    if (!pixel_span(fminf(a.y, b.y), fmaxf(a.y, b.y), target->height, &y0, &y1)) return;
+    for (int y=y0; y<y1; y++) {
+        Color *row = target->pixels + y*target->width + x0;
+        if (color.a == 255) fill_span(row, color, x1 - x0);
+        else blend_span_solid(row, color, x1 - x0);
+    }
+}
+
+// floorf without the libm call, texel coordinates are always small
+static inline int fast_floor(float x) {
+    int i = (int)x;
+    return i - (x < (float)i);
+}
+
+static inline Color sample_nearest(const SoftTexture *tex, float u, float v) {
+    int x = fast_floor(u), y = fast_floor(v);
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x >= tex->width) x = tex->width - 1;
+    if (y >= tex->height) y = tex->height - 1;
+    return tex->pixels[y*tex->width + x];
+}
+
+// two channels per multiply, weight in 0..256
+static inline uint32_t lerp_packed(uint32_t a, uint32_t b, unsigned int w) {
+    uint32_t rb = (((a & 0x00FF00FFu)*(256 - w) + (b & 0x00FF00FFu)*w) >> 8) & 0x00FF00FFu;
+    uint32_t ga = ((((a >> 8) & 0x00FF00FFu)*(256 - w) + ((b >> 8) & 0x00FF00FFu)*w)) & 0xFF00FF00u;
+    return rb | ga;
+}
+
+static inline Color sample_bilinear(const SoftTexture *tex, float u, float v) {
+    u -= 0.5f;
+    v -= 0.5f;
+    int x0 = fast_floor(u), y0 = fast_floor(v), x1 = x0 + 1, y1 = y0 + 1;
+    float tx = u - x0, ty = v - y0;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 < 0) x1 = 0;
+    if (y1 < 0) y1 = 0;
+    if (x0 >= tex->width) x0 = tex->width - 1;
+    if (x1 >= tex->width) x1 = tex->width - 1;
+    if (y0 >= tex->height) y0 = tex->height - 1;
+    if (y1 >= tex->height) y1 = tex->height - 1;
+    uint32_t p00, p10, p01, p11;
+    memcpy(&p00, &tex->pixels[y0*tex->width + x0], 4);
+    memcpy(&p10, &tex->pixels[y0*tex->width + x1], 4);
+    memcpy(&p01, &tex->pixels[y1*tex->width + x0], 4);
+    memcpy(&p11, &tex->pixels[y1*tex->width + x1], 4);
+    unsigned int wx = (unsigned int)(tx*256.0f), wy = (unsigned int)(ty*256.0f);
+    uint32_t out = lerp_packed(lerp_packed(p00, p10, wx), lerp_packed(p01, p11, wx), wy);
+    Color c;
+    memcpy(&c, &out, 4);
+    return c;
+}
+
+// GL texcoords (in texels) for a pixel center inside dest - render textures are stored upside down
+static inline float source_u(Rectangle source, float t) {
+    return (source.width < 0) ? source.x + (1.0f - t)*-source.width : source.x + t*source.width;
+}
+
+static inline float source_v(Rectangle source, float t) {
+    return (source.height < 0) ? source.y + (1.0f - t)*-source.height : source.y + t*source.height;
+}
+
+static void blit(SoftTexture *tex, Rectangle source, Rectangle dest, Color tint) {
+    SoftTexture *target = texture_get(soft.target);
+    if (!target || tint.a == 0) return;
+    Vector2 a = to_target((Vector2){dest.x, dest.y});
+    Vector2 b = to_target((Vector2){dest.x + dest.width, dest.y + dest.height});
+    float w = b.x - a.x, h = b.y - a.y;
+    int x0, x1, y0, y1;
+    if (w <= 0 || h <= 0) return;
+    if (!pixel_span(a.x, b.x, target->width, &x0, &x1)) return;
+    if (!pixel_span(a.y, b.y, target->height, &y0, &y1)) return;
+    bool white = (tint.r & tint.g & tint.b & tint.a) == 255;
+    for (int x=x0; x<x1; x++) column_u[x - x0] = source_u(source, (x + 0.5f - a.x)/w);
+    for (int y=y0; y<y1; y++) {
+        float v = source_v(source, (y + 0.5f - a.y)/h);
+        if (tex->flipped) v = tex->height - v;
+        for (int x=0; x<x1-x0; x++) {
+            Color c = tex->bilinear ? sample_bilinear(tex, column_u[x], v) : sample_nearest(tex, column_u[x], v);
+            if (!white) c = (Color){div255(c.r*tint.r), div255(c.g*tint.g), div255(c.b*tint.b), div255(c.a*tint.a)};
+            row_buffer[x] = c;
+        }
+        blend_span(target->pixels + y*target->width + x0, row_buffer, x1 - x0);
+    }
+}
+
+// -- crt330.frag on the cpu, everything that only depends on the pixel is in tables
+static void crt_free(void) {
+    free(soft.crt.gain);
+    free(soft.crt.phase_sin);
+    free(soft.crt.phase_cos);
+    free(soft.crt.texel);
+    free(soft.crt.texel_x);
+    free(soft.crt.texel_y);
+    soft.crt.gain = NULL;
+}
+
+static void crt_prepare(SoftTexture *tex, Rectangle source, Rectangle dest, int x0, int y0, int x1, int y1, Vector2 a, Vector2 b) {
+    struct SoftCrt *crt = &soft.crt;
+    if (crt->gain && crt->x0 == x0 && crt->y0 == y0 && crt->x1 == x1 && crt->y1 == y1 &&
+        crt->tex_w == tex->width && crt->tex_h == tex->height &&
+        !memcmp(&crt->source, &source, sizeof(source)) && !memcmp(&crt->dest, &dest, sizeof(dest)) &&
+        !memcmp(crt->resolution, soft.resolution, sizeof(crt->resolution))) return;
+    int n = (x1 - x0)*(y1 - y0);
+    crt_free();
+    crt->gain = malloc(sizeof(float)*n);
+    crt->phase_sin = malloc(sizeof(float)*n);
+    crt->phase_cos = malloc(sizeof(float)*n);
+    crt->texel = malloc(sizeof(int)*n);
+    crt->texel_x = malloc(sizeof(short)*n);
+    crt->texel_y = malloc(sizeof(short)*n);
+    crt->x0 = x0; crt->y0 = y0; crt->x1 = x1; crt->y1 = y1;
+    crt->tex_w = tex->width;
+    crt->tex_h = tex->height;
+    crt->source = source;
+    crt->dest = dest;
+    memcpy(crt->resolution, soft.resolution, sizeof(crt->resolution));
+    for (int i=0; i<SOFT_POW_LUT; i++) crt->pow_lut[i] = powf(0.1f + 0.5f*i/(SOFT_POW_LUT - 1), 0.6f);
+
+    float w = b.x - a.x, h = b.y - a.y;
+    int i = 0;
+    for (int y=y0; y<y1; y++) {
+        for (int x=x0; x<x1; x++, i++) {
+            float u = source_u(source, (x + 0.5f - a.x)/w);
+            float v = source_v(source, (y + 0.5f - a.y)/h);
+            // curve()
+            float uvx = (u/tex->width - 0.5f)*2.0f*1.1f;
+            float uvy = (v/tex->height - 0.5f)*2.0f*1.1f;
+            uvx *= 1.0f + powf(fabsf(uvy)/8.8f, 2.0f);
+            uvy *= 1.0f + powf(fabsf(uvx)/8.2f, 2.0f);
+            uvx = (uvx/2.0f + 0.5f)*0.92f + 0.04f;
+            uvy = (uvy/2.0f + 0.5f)*0.92f + 0.04f;
+            float vig = 16.0f*uvx*uvy*(1.0f - uvx)*(1.0f - uvy);
+            bool outside = uvx < 0.0f || uvx > 1.0f || uvy < 0.0f || uvy > 1.0f;
+            crt->gain[i] = outside ? 0.0f : powf(vig, 0.3f);
+            crt->phase_sin[i] = sinf(uvy*soft.resolution[1]*1.3f);
+            crt->phase_cos[i] = cosf(uvy*soft.resolution[1]*1.3f);
+            int tx = fast_floor(u), ty = fast_floor(tex->flipped ? tex->height - v : v);
+            tx = (tx < 0) ? 0 : (tx >= tex->width) ? tex->width - 1 : tx;
+            ty = (ty < 0) ? 0 : (ty >= tex->height) ? tex->height - 1 : ty;
+            crt->texel_x[i] = (short)tx;
+            crt->texel_y[i] = (short)ty;
+            crt->texel[i] = ty*tex->width + tx;
+        }
+    }
+}
+
+// the second sample is the first one shifted by whole texels, exact for a 1:1 blit like the game's
+static inline Color crt_bleed(const SoftTexture *tex, const struct SoftCrt *crt, int i, int dx, int dy) {
+    int x = crt->texel_x[i] + dx, y = crt->texel_y[i] + dy;
+    x = (x < 0) ? 0 : (x >= tex->width) ? tex->width - 1 : x;
+    y = (y < 0) ? 0 : (y >= tex->height) ? tex->height - 1 : y;
+    return tex->pixels[y*tex->width + x];
+}
+
+static void crt_pass(SoftTexture *tex, Rectangle source, Rectangle dest) {
+    SoftTexture *target = texture_get(soft.target);
+    if (!target) return;
+    Vector2 a = to_target((Vector2){dest.x, dest.y});
+    Vector2 b = to_target((Vector2){dest.x + dest.width, dest.y + dest.height});
+    int x0, x1, y0, y1;
+    if (b.x - a.x <= 0 || b.y - a.y <= 0) return;
+    if (!pixel_span(a.x, b.x, target->width, &x0, &x1)) return;
+    if (!pixel_span(a.y, b.y, target->height, &y0, &y1)) return;
+    crt_prepare(tex, source, dest, x0, y0, x1, y1, a, b);
+
+    // per frame terms - uniform range_x/range_y keep their defaults 4.0/3.2
+    float t = soft.time_uniform;
+    float scan_sin = sinf(3.5f*t), scan_cos = cosf(3.5f*t);
+    float blink = 1.0f + 0.01f*sinf(60.0f*t);
+    int dx = fast_floor(0.5f - 4.0f/soft.resolution[0]*sinf(t)*tex->width);
+    int dy = fast_floor(0.5f - 3.2f/soft.resolution[1]*cosf(t)*tex->height);
+    if (tex->flipped) dy = -dy;
+    const float gain_r = 2.3f*0.6f, gain_g = 2.8f*0.6f, gain_b = 1.3f*0.6f;
+    const float lut_scale = (SOFT_POW_LUT - 1)/0.5f;
+    struct SoftCrt *crt = &soft.crt;
+    int width = x1 - x0;
+    int i = 0;
+#if defined(SOFT_SIMD)
+    __m128i zero = _mm_setzero_si128();
+    __m128 bleed_k = _mm_setr_ps(0.13f, 0.03f, 0.0f, 0.0f);
+    __m128 gain_k = _mm_setr_ps(gain_r, gain_g, gain_b, 0.0f);
+    __m128 alpha = _mm_setr_ps(0.0f, 0.0f, 0.0f, 255.0f);
+    __m128 v_sin = _mm_set1_ps(scan_sin), v_cos = _mm_set1_ps(scan_cos);
+    __m128 low = _mm_set1_ps(0.1f), high = _mm_set1_ps(0.6f);
+#endif
+    for (int y=y0; y<y1; y++) {
+        Color *row = target->pixels + y*target->width + x0;
+        int x = 0;
+#if defined(SOFT_SIMD)
+        // scanline and vignette factor for 4 pixels at once, then one pixel per register
+        for (; x + 4 <= width; x += 4, i += 4) {
+            __m128 scans = _mm_add_ps(low, _mm_mul_ps(_mm_set1_ps(0.1f), _mm_add_ps(_mm_mul_ps(v_sin, _mm_loadu_ps(crt->phase_cos + i)), _mm_mul_ps(v_cos, _mm_loadu_ps(crt->phase_sin + i)))));
+            scans = _mm_min_ps(_mm_max_ps(scans, low), high);
+            int idx[4];
+            _mm_storeu_si128((__m128i *)idx, _mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(scans, low), _mm_set1_ps(lut_scale))));
+            __m128 s = _mm_setr_ps(crt->pow_lut[idx[0]], crt->pow_lut[idx[1]], crt->pow_lut[idx[2]], crt->pow_lut[idx[3]]);
+            __m128 k = _mm_mul_ps(_mm_loadu_ps(crt->gain + i), _mm_mul_ps(_mm_add_ps(_mm_set1_ps(0.8f), _mm_mul_ps(_mm_set1_ps(0.5f), s)), _mm_set1_ps(blink)));
+            float kk[4];
+            _mm_storeu_ps(kk, k);
+            uint32_t out[4];
+            for (int j=0; j<4; j++) {
+                uint32_t pc, pl;
+                Color c = tex->pixels[crt->texel[i + j]];
+                Color l = crt_bleed(tex, crt, i + j, dx, dy);
+                memcpy(&pc, &c, 4);
+                memcpy(&pl, &l, 4);
+                __m128 vc = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)pc), zero), zero));
+                __m128 vl = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)pl), zero), zero));
+                vc = _mm_add_ps(_mm_mul_ps(_mm_add_ps(vc, _mm_mul_ps(vl, bleed_k)), _mm_mul_ps(gain_k, _mm_set1_ps(kk[j]))), alpha);
+                __m128i packed = _mm_cvtps_epi32(vc);
+                packed = _mm_packus_epi16(_mm_packs_epi32(packed, packed), zero);
+                out[j] = (uint32_t)_mm_cvtsi128_si32(packed);
+            }
+            memcpy(row + x, out, sizeof(out));
+        }
+#endif
+        for (; x<width; x++, i++) {
+            float scans = 0.1f + 0.10f*(scan_sin*crt->phase_cos[i] + scan_cos*crt->phase_sin[i]);
+            scans = (scans < 0.1f) ? 0.1f : (scans > 0.6f) ? 0.6f : scans;
+            float k = crt->gain[i]*(0.8f + 0.5f*crt->pow_lut[(int)((scans - 0.1f)*lut_scale)])*blink;
+            Color c = tex->pixels[crt->texel[i]];
+            Color l = crt_bleed(tex, crt, i, dx, dy);
+            float r = (c.r + l.r*0.13f)*gain_r*k;
+            float g = (c.g + l.g*0.03f)*gain_g*k;
+            float bl = c.b*gain_b*k;
+            row[x] = (Color){(unsigned char)fminf(r + 0.5f, 255.0f), (unsigned char)fminf(g + 0.5f, 255.0f), (unsigned char)fminf(bl + 0.5f, 255.0f), 255};
+        }
+    }
+}
+
+// -- headless platform
+void soft_press_key(int key) {
+    if (key < 0 || key >= SOFT_MAX_KEYS) return;
+    platform.key_pressed[key] = true;
+    soft_tap_key(key);
+}
+
+void soft_tap_key(int key) {
+    if (key <= 0 || key >= SOFT_MAX_KEYS || platform.key_queue_count == SOFT_KEY_QUEUE) return;
+    platform.key_queue[platform.key_queue_count++] = key;
+}
+
+void soft_set_key_down(int key, bool down) {
+    if (key < 0 || key >= SOFT_MAX_KEYS) return;
+    platform.key_down[key] = down;
+}
+
+void soft_set_frame_time(float seconds) {
+    platform.frame_time = seconds;
+}
+
+void soft_set_hidden(bool hidden) {
+    platform.hidden = hidden;
+}
+
+long soft_frame_count(void) {
+    return platform.frames;
+}
+
+void soft_end_frame(void) {
+    platform.frames++;
+    platform.time += platform.frame_time;
+    memset(platform.key_pressed, 0, sizeof(platform.key_pressed));
+    platform.key_queue_count = 0;
+}
+
+Image soft_screenshot(void) {
+    SoftTexture *window = texture_get(soft.window);
+    Image image = {0};
+    if (!window) return image;
+    image.data = malloc(sizeof(Color)*window->width*window->height);
+    memcpy(image.data, window->pixels, sizeof(Color)*window->width*window->height);
+    image.width = window->width;
+    image.height = window->height;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return image;
+}
+
+void InitWindow(int width, int height, const char *title) {
+    (void)title;
+    if (width > SOFT_MAX_WIDTH) width = SOFT_MAX_WIDTH;
+    soft.width = width;
+    soft.height = height;
+    soft.window = texture_alloc(width, height, calloc(width*height, sizeof(Color)));
+    soft.target = soft.window;
+}
+
+void CloseWindow(void) {
+    texture_free(soft.window);
+    crt_free();
+}
+
+bool WindowShouldClose(void) { return false; }
+void SetWindowState(unsigned int flags) { (void)flags; }
+void SetWindowPosition(int x, int y) { (void)x; (void)y; }
+// frame pacing moves the virtual clock instead of sleeping
+void SetTargetFPS(int fps) { if (fps > 0) platform.frame_time = 1.0f/fps; }
+bool IsWindowHidden(void) { return platform.hidden; }
+bool IsWindowMinimized(void) { return false; }
+int GetScreenWidth(void) { return soft.width; }
+int GetScreenHeight(void) { return soft.height; }
+float GetFrameTime(void) { return platform.frame_time; }
+double GetTime(void) { return platform.time; }
+
+bool IsKeyPressed(int key) { return key >= 0 && key < SOFT_MAX_KEYS && platform.key_pressed[key]; }
+bool IsKeyDown(int key) { return key >= 0 && key < SOFT_MAX_KEYS && (platform.key_down[key] || platform.key_pressed[key]); }
+// presses of this frame in order, 0 once drained
+int GetKeyPressed(void) {
+    if (platform.key_queue_count == 0) return 0;
+    int key = platform.key_queue[0];
+    platform.key_queue_count--;
+    memmove(platform.key_queue, platform.key_queue + 1, platform.key_queue_count*sizeof(int));
+    return key;
+}
+
+void SetRandomSeed(unsigned int seed) {
+    platform.seed = seed ? seed : 0x2545F491u;
+}
+
+int GetRandomValue(int min, int max) {
+    if (min > max) {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+    // xorshift32 - same sequence on every platform so golden frames stay stable
+    unsigned int x = platform.seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    platform.seed = x;
+    return (int)(x % (unsigned int)(max - min + 1)) + min;
+}
+
+// audio is not part of the picture
+void InitAudioDevice(void) {}
+void CloseAudioDevice(void) {}
+Sound LoadSound(const char *fileName) { (void)fileName; return (Sound){0}; }
+void UnloadSound(Sound sound) { (void)sound; }
+void PlaySound(Sound sound) { (void)sound; }
+void PlaySoundMulti(Sound sound) { (void)sound; }
+void StopSoundMulti(void) {}
+
+// -- drawing state
+void BeginDrawing(void) {
+    soft.target = soft.window;
+}
+
+void EndDrawing(void) {
+    soft_end_frame();
+}
+
+void BeginTextureMode(RenderTexture2D target) {
+    if (texture_get(target.texture.id)) soft.target = target.texture.id;
+}
+
+void EndTextureMode(void) {
+    soft.target = soft.window;
+}
+
+void BeginMode2D(Camera2D camera) {
+    soft.camera = camera;
+    soft.mode2d = true;
+}
+
+void EndMode2D(void) {
+    soft.mode2d = false;
+}
+
+void ClearBackground(Color color) {
+    SoftTexture *target = texture_get(soft.target);
+    if (!target) return;
+    fill_span(target->pixels, color, target->width*target->height);
+}
+
+// -- shaders, only the crt post process is known
+Shader LoadShader(const char *vsFileName, const char *fsFileName) {
+    (void)vsFileName;
+    Shader shader = {0};
+    if (fsFileName && strstr(fsFileName, "crt")) shader.id = SOFT_SHADER_CRT;
+    return shader;
+}
+
+void UnloadShader(Shader shader) { (void)shader; }
+
+int GetShaderLocation(Shader shader, const char *uniformName) {
+    if (shader.id != SOFT_SHADER_CRT) return -1;
+    if (!strcmp(uniformName, "resolution")) return 0;
+    if (!strcmp(uniformName, "time")) return 1;
+    return -1;
+}
+
+void SetShaderValue(Shader shader, int locIndex, const void *value, int uniformType) {
+    (void)uniformType;
+    if (shader.id != SOFT_SHADER_CRT) return;
+    if (locIndex == 0) memcpy(soft.resolution, value, sizeof(soft.resolution));
+    if (locIndex == 1) memcpy(&soft.time_uniform, value, sizeof(float));
+}
+
+void BeginShaderMode(Shader shader) {
+    soft.shader = shader.id;
+}
+
+void EndShaderMode(void) {
+    soft.shader = SOFT_SHADER_DEFAULT;
+}
+
+// -- images and textures
+Image LoadImage(const char *fileName) {
+    Image image = {0};
+    int comp = 0;
+    image.data = stbi_load(fileName, &image.width, &image.height, &comp, 4);
+    if (!image.data) return (Image){0};
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return image;
+}
+
+void UnloadImage(Image image) {
+    free(image.data);
+}
+
+bool ExportImage(Image image, const char *fileName) {
+    if (!image.data || image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) return false;
+    return stbi_write_png(fileName, image.width, image.height, 4, image.data, image.width*4) != 0;
+}
+
+Texture2D LoadTexture(const char *fileName) {
+    Image image = LoadImage(fileName);
+    Texture2D texture = {0};
+    if (!image.data) return texture;
+    // stb allocates with malloc, the texture takes the pixels over
+    texture.id = texture_alloc(image.width, image.height, image.data);
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.mipmaps = 1;
+    texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return texture;
+}
+
+RenderTexture2D LoadRenderTexture(int width, int height) {
+    RenderTexture2D target = {0};
+    target.texture.id = texture_alloc(width, height, calloc(width*height, sizeof(Color)));
+    if (!target.texture.id) return target;
+    soft.textures[target.texture.id].flipped = true;
+    target.id = target.texture.id;
+    target.texture.width = width;
+    target.texture.height = height;
+    target.texture.mipmaps = 1;
+    target.texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return target;
+}
+
+void UnloadTexture(Texture2D texture) { texture_free(texture.id); }
+void UnloadRenderTexture(RenderTexture2D target) { texture_free(target.texture.id); }
+void GenTextureMipmaps(Texture2D *texture) { (void)texture; }
+
+void SetTextureFilter(Texture2D texture, int filter) {
+    SoftTexture *tex = texture_get(texture.id);
+    if (tex) tex->bilinear = (filter != TEXTURE_FILTER_POINT);
+}
+
+Color GetColor(unsigned int hexValue) {
+    return (Color){(hexValue >> 24) & 0xFF, (hexValue >> 16) & 0xFF, (hexValue >> 8) & 0xFF, hexValue & 0xFF};
+}
+
+// -- shapes
+void DrawRectangle(int posX, int posY, int width, int height, Color color) {
+    fill_rect((Rectangle){posX, posY, width, height}, color);
+}
+
+void DrawRectangleRec(Rectangle rec, Color color) {
+    fill_rect(rec, color);
+}
+
+// same quad as raylib: the segment pushed out thick/2 on both sides
+void DrawLineEx(Vector2 startPos, Vector2 endPos, float thick, Color color) {
+    SoftTexture *target = texture_get(soft.target);
+    float dx = endPos.x - startPos.x, dy = endPos.y - startPos.y;
+    float length = sqrtf(dx*dx + dy*dy);
+    if (!target || length <= 0.0f || thick <= 0.0f || color.a == 0) return;
+    float scale = thick/(2.0f*length);
+    Vector2 radius = {-scale*dy, scale*dx};
+    Vector2 quad[4] = {
+        to_target((Vector2){startPos.x - radius.x, startPos.y - radius.y}),
+        to_target((Vector2){endPos.x - radius.x, endPos.y - radius.y}),
+        to_target((Vector2){endPos.x + radius.x, endPos.y + radius.y}),
+        to_target((Vector2){startPos.x + radius.x, startPos.y + radius.y}),
+    };
+    float min_x = quad[0].x, max_x = quad[0].x, min_y = quad[0].y, max_y = quad[0].y;
+    for (int i=1; i<4; i++) {
+        min_x = fminf(min_x, quad[i].x);
+        max_x = fmaxf(max_x, quad[i].x);
+        min_y = fminf(min_y, quad[i].y);
+        max_y = fmaxf(max_y, quad[i].y);
+    }
+    int x0, x1, y0, y1;
+    if (!pixel_span(min_x, max_x, target->width, &x0, &x1)) return;
+    if (!pixel_span(min_y, max_y, target->height, &y0, &y1)) return;
+    for (int y=y0; y<y1; y++) {
+        // convex quad - the covered part of a row is one span
+        int first = -1, last = -1;
+        for (int x=x0; x<x1; x++) {
+            float px = x + 0.5f, py = y + 0.5f;
+            int positive = 0, negative = 0;
+            for (int e=0; e<4; e++) {
+                Vector2 p = quad[e], q = quad[(e + 1)%4];
+                float side = (q.x - p.x)*(py - p.y) - (q.y - p.y)*(px - p.x);
+                if (side > 0) positive++;
+                else if (side < 0) negative++;
+            }
+            if (positive == 0 || negative == 0) {
+                if (first < 0) first = x;
+                last = x + 1;
+            }
+        }
+        if (first < 0) continue;
+        Color *row = target->pixels + y*target->width + first;
+        if (color.a == 255) fill_span(row, color, last - first);
+        else blend_span_solid(row, color, last - first);
+    }
+}
+
+// -- textures on screen
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    (void)rotation; // the game never rotates a texture
+    SoftTexture *tex = texture_get(texture.id);
+    if (!tex) return;
+    dest.x -= origin.x;
+    dest.y -= origin.y;
+    if (soft.shader == SOFT_SHADER_CRT) crt_pass(tex, source, dest);
+    else blit(tex, source, dest, tint);
+}
+
+void DrawTexture(Texture2D texture, int posX, int posY, Color tint) {
+    DrawTexturePro(texture, (Rectangle){0, 0, texture.width, texture.height}, (Rectangle){posX, posY, texture.width, texture.height}, (Vector2){0, 0}, 0.0f, tint);
+}
+
+// -- text
+int GetCodepoint(const char *text, int *bytesProcessed) {
+    const unsigned char *s = (const unsigned char *)text;
+    *bytesProcessed = 1;
+    if (s[0] < 0x80) return s[0];
+    if ((s[0] & 0xE0) == 0xC0 && (s[1] & 0xC0) == 0x80) {
+        *bytesProcessed = 2;
+        return ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+    }
+    if ((s[0] & 0xF0) == 0xE0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80) {
+        *bytesProcessed = 3;
+        return ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+    }
+    return 0x3f;
+}
+
+int GetGlyphIndex(Font font, int codepoint) {
+    int fallback = 0;
+    for (int i=0; i<font.glyphCount; i++) {
+        if (font.glyphs[i].value == codepoint) return i;
+        if (font.glyphs[i].value == 0x3f) fallback = i;
+    }
+    return fallback;
+}
+
+Font LoadFontEx(const char *fileName, int fontSize, int *fontChars, int glyphCount) {
+    Font font = {0};
+    FILE *file = fopen(fileName, "rb");
+    if (!file) return font;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *data = malloc(size);
+    bool loaded = fread(data, 1, size, file) == (size_t)size;
+    fclose(file);
+    stbtt_fontinfo info;
+    if (!loaded || !stbtt_InitFont(&info, data, stbtt_GetFontOffsetForIndex(data, 0))) {
+        free(data);
+        return font;
+    }
+    glyphCount = (glyphCount > 0) ? glyphCount : 95;
+    font.baseSize = fontSize;
+    font.glyphCount = glyphCount;
+    font.glyphPadding = SOFT_GLYPH_PADDING;
+    font.glyphs = calloc(glyphCount, sizeof(GlyphInfo));
+    font.recs = calloc(glyphCount, sizeof(Rectangle));
+
+    // same metrics as raylib LoadFontData()
+    float scale = stbtt_ScaleForPixelHeight(&info, (float)fontSize);
+    int ascent, descent, line_gap;
+    stbtt_GetFontVMetrics(&info, &ascent, &descent, &line_gap);
+    unsigned char **bitmaps = calloc(glyphCount, sizeof(unsigned char *));
+    int pen_x = SOFT_GLYPH_PADDING, pen_y = SOFT_GLYPH_PADDING, shelf = 0;
+    for (int i=0; i<glyphCount; i++) {
+        GlyphInfo *glyph = &font.glyphs[i];
+        int w = 0, h = 0;
+        glyph->value = fontChars ? fontChars[i] : 32 + i;
+        if (stbtt_FindGlyphIndex(&info, glyph->value) > 0) {
+            bitmaps[i] = stbtt_GetCodepointBitmap(&info, scale, scale, glyph->value, &w, &h, &glyph->offsetX, &glyph->offsetY);
+        }
+        stbtt_GetCodepointHMetrics(&info, glyph->value, &glyph->advanceX, NULL);
+        glyph->advanceX = (int)(glyph->advanceX*scale);
+        glyph->offsetY += (int)(ascent*scale);
+        if (glyph->value == 32) {
+            w = glyph->advanceX;
+            h = fontSize;
+        }
+        // shelf packing, padding on every side keeps bilinear taps inside the glyph
+        if (pen_x + w + SOFT_GLYPH_PADDING > SOFT_ATLAS_WIDTH) {
+            pen_x = SOFT_GLYPH_PADDING;
+            pen_y += shelf + 2*SOFT_GLYPH_PADDING;
+            shelf = 0;
+        }
+        font.recs[i] = (Rectangle){pen_x, pen_y, w, h};
+        pen_x += w + 2*SOFT_GLYPH_PADDING;
+        if (h > shelf) shelf = h;
+    }
+    int atlas_h = pen_y + shelf + SOFT_GLYPH_PADDING;
+    Color *atlas = calloc(SOFT_ATLAS_WIDTH*atlas_h, sizeof(Color));
+    for (int i=0; i<glyphCount; i++) {
+        if (!bitmaps[i]) continue;
+        Rectangle rec = font.recs[i];
+        for (int y=0; y<(int)rec.height; y++) {
+            for (int x=0; x<(int)rec.width; x++) {
+                atlas[((int)rec.y + y)*SOFT_ATLAS_WIDTH + (int)rec.x + x] = (Color){255, 255, 255, bitmaps[i][y*(int)rec.width + x]};
+            }
+        }
+        stbtt_FreeBitmap(bitmaps[i], NULL);
+    }
+    free(bitmaps);
+    free(data);
+    font.texture.id = texture_alloc(SOFT_ATLAS_WIDTH, atlas_h, atlas);
+    font.texture.width = SOFT_ATLAS_WIDTH;
+    font.texture.height = atlas_h;
+    font.texture.mipmaps = 1;
+    font.texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return font;
+}
+
+void UnloadFont(Font font) {
+    UnloadTexture(font.texture);
+    free(font.glyphs);
+    free(font.recs);
+}
+
+void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {
+    if (font.texture.id == 0) return;
+    float scale = fontSize/font.baseSize;
+    float offset_x = 0.0f, offset_y = 0.0f;
+    for (int i=0; text[i] != '\0';) {
+        int bytes = 0;
+        int codepoint = GetCodepoint(&text[i], &bytes);
+        int index = GetGlyphIndex(font, codepoint);
+        if (codepoint == '\n') {
+            offset_y += (int)((font.baseSize + font.baseSize/2.0f)*scale);
+            offset_x = 0.0f;
+        } else {
+            if (codepoint != ' ' && codepoint != '\t') {
+                // DrawTextCodepoint(): the padded atlas rect, scaled
+                GlyphInfo *glyph = &font.glyphs[index];
+                Rectangle rec = font.recs[index];
+                float pad = (float)font.glyphPadding;
+                Rectangle source = {rec.x - pad, rec.y - pad, rec.width + 2.0f*pad, rec.height + 2.0f*pad};
+                Rectangle dest = {position.x + offset_x + glyph->offsetX*scale - pad*scale,
+                                  position.y + offset_y + glyph->offsetY*scale - pad*scale,
+                                  source.width*scale, source.height*scale};
+                DrawTexturePro(font.texture, source, dest, (Vector2){0, 0}, 0.0f, tint);
+            }
+            if (font.glyphs[index].advanceX == 0) offset_x += font.recs[index].width*scale + spacing;
+            else offset_x += font.glyphs[index].advanceX*scale + spacing;
+        }
+        i += bytes;
+    }
+}
+
+Vector2 MeasureTextEx(Font font, const char *text, float fontSize, float spacing) {
+    Vector2 size = {0};
+    if (font.glyphCount == 0) return size;
+    float width = 0.0f, widest = 0.0f;
+    int count = 0, widest_count = 0, lines = 1;
+    for (int i=0; text[i] != '\0';) {
+        int bytes = 0;
+        int codepoint = GetCodepoint(&text[i], &bytes);
+        int index = GetGlyphIndex(font, codepoint);
+        i += bytes;
+        if (codepoint == '\n') {
+            if (width > widest) widest = width;
+            if (count > widest_count) widest_count = count;
+            width = 0.0f;
+            count = 0;
+            lines++;
+            continue;
+        }
+        count++;
+        if (font.glyphs[index].advanceX != 0) width += font.glyphs[index].advanceX;
+        else width += font.recs[index].width + font.glyphs[index].offsetX;
+    }
+    if (width > widest) widest = width;
+    if (count > widest_count) widest_count = count;
+    float scale = fontSize/font.baseSize;
+    size.x = widest*scale + (widest_count - 1)*spacing;
+    size.y = font.baseSize*scale*lines;
+    return size;
+}
+
+// raylib default font glyph widths for ' '..'~', MeasureText() measures with it
+static const int default_widths[95] = {
+    3, 1, 4, 6, 5, 7, 6, 2, 3, 3, 5, 5, 2, 4, 1, 7, 5, 2, 5, 5, 5, 5, 5, 5, 5, 5, 1, 1, 3, 4, 3, 6,
+    7, 6, 6, 6, 6, 6, 6, 6, 6, 3, 5, 6, 5, 7, 6, 6, 6, 6, 6, 6, 7, 6, 7, 7, 6, 6, 6, 2, 7, 2, 3, 5,
+    2, 5, 5, 5, 5, 5, 4, 5, 5, 1, 2, 5, 2, 5, 5, 5, 5, 5, 5, 5, 4, 5, 5, 5, 5, 5, 5, 3, 1, 3, 4
+};
+
+int MeasureText(const char *text, int fontSize) {
+    if (fontSize < 10) fontSize = 10;
+    int spacing = fontSize/10;
+    int width = 0, count = 0;
+    for (int i=0; text[i] != '\0';) {
+        int bytes = 0;
+        int codepoint = GetCodepoint(&text[i], &bytes);
+        width += (codepoint >= 32 && codepoint < 127) ? default_widths[codepoint - 32] : 5;
+        count++;
+        i += bytes;
+    }
+    if (count == 0) return 0;
+    return (int)(width*fontSize/10.0f + (count - 1)*spacing);
+}
+
+const char *TextFormat(const char *text, ...) {
+    static char buffers[4][1024];
+    static int index = 0;
+    char *buffer = buffers[index];
+    index = (index + 1)%4;
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, sizeof(buffers[0]), text, args);
+    va_end(args);
+    return buffer;
+}
+
+// raylib 4.2 CheckCollisionCircleRec - the rules depend on its exact shape
+bool CheckCollisionCircleRec(Vector2 center, float radius, Rectangle rec) {
+    int rec_center_x = (int)(rec.x + rec.width/2.0f);
+    int rec_center_y = (int)(rec.y + rec.height/2.0f);
+    float dx = fabsf(center.x - (float)rec_center_x);
+    float dy = fabsf(center.y - (float)rec_center_y);
+    if (dx > (rec.width/2.0f + radius)) return false;
+    if (dy > (rec.height/2.0f + radius)) return false;
+    if (dx <= (rec.width/2.0f)) return true;
+    if (dy <= (rec.height/2.0f)) return true;
+    float corner = (dx - rec.width/2.0f)*(dx - rec.width/2.0f) + (dy - rec.height/2.0f)*(dy - rec.height/2.0f);
+    return corner <= (radius*radius);
+}
@@ -0,0 +1,41 @@
+/*******************************************************************************************
+*
+*   raylib study [softrender.h] - Pong _ software render backend
+*
+*   CPU implementation of the slice of the raylib API the game uses: filled rectangles,
+*   thick lines, texture and font-atlas glyph blits, render textures, a CPU port of the
+*   crt330.frag post process and a headless platform (virtual clock, scripted keys, no audio).
+*   Link it instead of libraylib to run UpdateDrawFrame without a window or GPU.
+*
+*   Blending follows raylib's default BLEND_ALPHA, fills and blends run 4 pixels at a time
+*   with SSE2 when available (emscripten maps it to wasm simd with -msimd128), define
+*   SOFT_NO_SIMD to check the scalar path.
+*
+********************************************************************************************/
+
+#ifndef SOFTRENDER_H
+#define SOFTRENDER_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#define SOFT_MAX_TEXTURES 64
+#define SOFT_MAX_KEYS 512
+#define SOFT_KEY_QUEUE 16 /* GetKeyPressed, same as raylib */
+
+// headless platform - key presses last one frame, EndDrawing advances the clock by the
+// frame time (SetTargetFPS sets it too), state is per thread and soft_end_frame closes a
+// frame that was never drawn. A tap is a press and release between two polls, raylib only
+// reports it through GetKeyPressed.
+void soft_press_key(int key);
+void soft_tap_key(int key);
+void soft_set_key_down(int key, bool down);
+void soft_set_frame_time(float seconds);
+void soft_set_hidden(bool hidden);
+long soft_frame_count(void);
+void soft_end_frame(void);
+
+// copy of the window framebuffer as R8G8B8A8, free with UnloadImage
+Image soft_screenshot(void);
+
+#endif // SOFTRENDER_H
@@ -0,0 +1,208 @@
+/*******************************************************************************************
+*
+*   raylib study [telemetry.c] - Pong _ match telemetry
+*
+*   Game licensed under MIT.
+*
+********************************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "telemetry.h"
+
+// -- encoding
+static size_t put_varint(unsigned char *out, uint32_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (unsigned char)value;
+    return n;
+}
+
+static uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static void put_u32(FILE *file, uint32_t value) {
+    unsigned char b[4] = {value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, (value >> 24) & 0xFF};
+    fwrite(b, 1, 4, file);
+}
+
+static bool get_u32(FILE *file, uint32_t *value) {
+    unsigned char b[4];
+    if (fread(b, 1, 4, file) != 4) return false;
+    *value = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+    return true;
+}
+
+static void write_column(Telemetry *telemetry, size_t size) {
+    put_u32(telemetry->file, (uint32_t)size);
+    fwrite(telemetry->encoded, 1, size, telemetry->file);
+}
+
+static void write_delta_column(Telemetry *telemetry, const int32_t *values, int count) {
+    size_t size = 0;
+    int32_t prev = 0;
+    for (int i=0; i<count; i++) {
+        size += put_varint(telemetry->encoded + size, zigzag((int32_t)((uint32_t)values[i] - (uint32_t)prev)));
+        prev = values[i];
+    }
+    write_column(telemetry, size);
+}
+
+static void write_block(Telemetry *telemetry, TelemetryBlock *block) {
+    if (block->count == 0) return;
+    fwrite("PTLB", 1, 4, telemetry->file);
+    put_u32(telemetry->file, (uint32_t)block->count);
+    write_delta_column(telemetry, (const int32_t *)block->frame, block->count);
+    memcpy(telemetry->encoded, block->type, block->count);
+    write_column(telemetry, block->count);
+    memcpy(telemetry->encoded, block->side, block->count);
+    write_column(telemetry, block->count);
+    write_delta_column(telemetry, block->x, block->count);
+    write_delta_column(telemetry, block->y, block->count);
+    write_delta_column(telemetry, block->angle, block->count);
+    write_delta_column(telemetry, block->speed, block->count);
+    telemetry->written += block->count;
+    telemetry->sealed = telemetry->frame;
+    block->count = 0;
+}
+
+// -- writer
+bool telemetry_open(Telemetry *telemetry, const char *path) {
+    memset(telemetry, 0, sizeof(*telemetry));
+    telemetry->active = &telemetry->blocks[0];
+    telemetry->file = fopen(path, "ab");
+    if (!telemetry->file) {
+        telemetry->active = NULL;
+        return false;
+    }
+    // header only once - later matches are appended as more blocks
+    fseek(telemetry->file, 0, SEEK_END);
+    if (ftell(telemetry->file) == 0) {
+        unsigned char header[8] = {'P','T','E','L', TELEMETRY_VERSION & 0xFF, TELEMETRY_VERSION >> 8, TELEMETRY_COLUMNS, 0};
+        fwrite(header, 1, sizeof(header), telemetry->file);
+    }
+    return true;
+}
+
+// no file - events stay in the active block until the caller resets its count
+void telemetry_open_memory(Telemetry *telemetry) {
+    memset(telemetry, 0, sizeof(*telemetry));
+    telemetry->active = &telemetry->blocks[0];
+}
+
+void telemetry_close(Telemetry *telemetry) {
+    if (!telemetry->file) return;
+    telemetry_flush(telemetry, true);
+    fclose(telemetry->file);
+    telemetry->file = NULL;
+    telemetry->active = NULL;
+}
+
+void telemetry_tick(Telemetry *telemetry) {
+    telemetry->frame++;
+}
+
+void telemetry_record(Telemetry *telemetry, TelemetryEvent type, TelemetrySide side, float x, float y, float angle, float speed) {
+    if (!telemetry->active) return;
+    TelemetryBlock *block = telemetry->active;
+    if (block->count == TELEMETRY_BLOCK_EVENTS && !telemetry->file) {
+        // memory sink the caller did not reset in time
+        telemetry->dropped++;
+        return;
+    }
+    if (block->count == TELEMETRY_BLOCK_EVENTS) {
+        // more than a block in one frame, nothing else to do but write it now
+        if (telemetry->pending) telemetry_flush(telemetry, false);
+        telemetry->pending = block;
+        telemetry->active = (block == &telemetry->blocks[0]) ? &telemetry->blocks[1] : &telemetry->blocks[0];
+        block = telemetry->active;
+    }
+    int i = block->count++;
+    block->frame[i] = telemetry->frame;
+    block->type[i] = (uint8_t)type;
+    block->side[i] = (uint8_t)side;
+    block->x[i] = (int32_t)lrintf(x*4.0f);
+    block->y[i] = (int32_t)lrintf(y*4.0f);
+    block->angle[i] = (int32_t)lrintf(angle*(18000.0f/3.14159265f));
+    block->speed[i] = (int32_t)lrintf(speed);
+    if (type == TELEMETRY_POINT) telemetry->point = true;
+}
+
+// end of frame - writes the block handed over by telemetry_record, partial also writes the
+// open one, so does the first point after TELEMETRY_SEAL_FRAMES without a write
+void telemetry_flush(Telemetry *telemetry, bool partial) {
+    if (!telemetry->file) return;
+    if (telemetry->pending) {
+        write_block(telemetry, telemetry->pending);
+        telemetry->pending = NULL;
+    }
+    bool seal = telemetry->point && telemetry->frame - telemetry->sealed >= TELEMETRY_SEAL_FRAMES;
+    telemetry->point = false;
+    if (partial || seal) {
+        write_block(telemetry, telemetry->active);
+        fflush(telemetry->file);
+    }
+}
+
+// -- reader
+bool telemetry_read_header(FILE *file) {
+    unsigned char header[8];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header)) return false;
+    if (memcmp(header, "PTEL", 4) != 0) return false;
+    if ((header[4] | (header[5] << 8)) != TELEMETRY_VERSION) return false;
+    return header[6] == TELEMETRY_COLUMNS;
+}
+
+static bool read_column(FILE *file, unsigned char *buffer, uint32_t capacity, uint32_t *size) {
+    if (!get_u32(file, size) || *size > capacity) return false;
+    return fread(buffer, 1, *size, file) == *size;
+}
+
+static bool read_delta_column(FILE *file, unsigned char *buffer, int32_t *values, int count) {
+    uint32_t size;
+    if (!read_column(file, buffer, TELEMETRY_MAX_COLUMN_BYTES, &size)) return false;
+    uint32_t pos = 0;
+    int32_t prev = 0;
+    for (int i=0; i<count; i++) {
+        uint32_t value = 0;
+        int shift = 0;
+        for (;;) {
+            if (pos >= size || shift > 28) return false;
+            unsigned char b = buffer[pos++];
+            value |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+            shift += 7;
+        }
+        prev = (int32_t)((uint32_t)prev + (uint32_t)unzigzag(value));
+        values[i] = prev;
+    }
+    return pos == size;
+}
+
+// returns the number of events in the block, 0 at the end of the file and -1 when corrupt
+int telemetry_read_block(FILE *file, TelemetryBlock *block) {
+    static unsigned char buffer[TELEMETRY_MAX_COLUMN_BYTES];
+    unsigned char magic[4];
+    uint32_t count, size;
+    size_t got = fread(magic, 1, 4, file);
+    if (got == 0) return 0;
+    if (got != 4 || memcmp(magic, "PTLB", 4) != 0) return -1;
+    if (!get_u32(file, &count) || count == 0 || count > TELEMETRY_BLOCK_EVENTS) return -1;
+    block->count = (int)count;
+    if (!read_delta_column(file, buffer, (int32_t *)block->frame, count)) return -1;
+    if (!read_column(file, block->type, count, &size) || size != count) return -1;
+    if (!read_column(file, block->side, count, &size) || size != count) return -1;
+    if (!read_delta_column(file, buffer, block->x, count)) return -1;
+    if (!read_delta_column(file, buffer, block->y, count)) return -1;
+    if (!read_delta_column(file, buffer, block->angle, count)) return -1;
+    if (!read_delta_column(file, buffer, block->speed, count)) return -1;
+    return (int)count;
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************************
+*
+*   raylib study [telemetry.h] - Pong _ match telemetry
+*
+*   Gameplay events (paddle/corner hits, smashes, wall hits, points) go into preallocated
+*   column buffers. Full blocks are handed over to a second buffer and written at the end of
+*   the frame, so recording an event is just a few stores. The open block is also written at
+*   the first point after TELEMETRY_SEAL_FRAMES without a write - a match on the web never
+*   reaches telemetry_close and a crash loses at most that much.
+*
+*   File layout (little endian, append-only):
+*       header: "PTEL" u16 version u16 column count
+*       block:  "PTLB" u32 event count, then per column: u32 byte size + encoded bytes
+*   Columns are delta encoded against the previous event in the block and stored as zigzag
+*   varints - type and side are single raw bytes.
+*
+********************************************************************************************/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_BLOCK_EVENTS 4096
+#define TELEMETRY_COLUMNS 7
+#define TELEMETRY_MAX_COLUMN_BYTES (TELEMETRY_BLOCK_EVENTS*5)
+#define TELEMETRY_SEAL_FRAMES (60*60*5) /* five minutes at 60 Hz */
+
+typedef enum TelemetryEvent {
+    TELEMETRY_PADDLE_HIT = 0,
+    TELEMETRY_CORNER_HIT,
+    TELEMETRY_SMASH,
+    TELEMETRY_SMASH_BACK,
+    TELEMETRY_WALL_HIT,
+    TELEMETRY_POINT,
+    TELEMETRY_EVENT_COUNT
+} TelemetryEvent;
+
+typedef enum TelemetrySide { TELEMETRY_HUMAN = 0, TELEMETRY_COMPUTER, TELEMETRY_NONE } TelemetrySide;
+
+// one event - angle in centidegrees, position in quarter pixels, speed in pixels per second
+typedef struct TelemetryRecord {
+    uint32_t frame;
+    uint8_t type, side;
+    int32_t x, y, angle, speed;
+} TelemetryRecord;
+
+typedef struct TelemetryBlock {
+    int count;
+    uint32_t frame[TELEMETRY_BLOCK_EVENTS];
+    uint8_t type[TELEMETRY_BLOCK_EVENTS], side[TELEMETRY_BLOCK_EVENTS];
+    int32_t x[TELEMETRY_BLOCK_EVENTS], y[TELEMETRY_BLOCK_EVENTS];
+    int32_t angle[TELEMETRY_BLOCK_EVENTS], speed[TELEMETRY_BLOCK_EVENTS];
+} TelemetryBlock;
+
+typedef struct Telemetry {
+    FILE *file;
+    uint32_t frame;
+    TelemetryBlock *active, *pending;
+    TelemetryBlock blocks[2];
+    unsigned char encoded[TELEMETRY_MAX_COLUMN_BYTES];
+    bool point; /* a rally ended this frame */
+    uint32_t sealed; /* frame of the last block write */
+    long written, dropped; /* dropped - full memory sink */
+} Telemetry;
+
+// writer - telemetry_record is safe to call on a closed sink and does nothing,
+// a memory sink keeps the events in the active block for the caller to read and reset
+bool telemetry_open(Telemetry *telemetry, const char *path);
+void telemetry_open_memory(Telemetry *telemetry);
+void telemetry_close(Telemetry *telemetry);
+void telemetry_tick(Telemetry *telemetry);
+void telemetry_record(Telemetry *telemetry, TelemetryEvent type, TelemetrySide side, float x, float y, float angle, float speed);
+void telemetry_flush(Telemetry *telemetry, bool partial);
+
+// reader - one block at a time, memory use does not depend on the file size
+bool telemetry_read_header(FILE *file);
+int telemetry_read_block(FILE *file, TelemetryBlock *block);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,130 @@
+/*******************************************************************************************
+*
+*   raylib study [tools/ai_tournament.c] - Pong _ headless ai tournament
+*
+*   Plays the computer paddle against the human paddle ai (the old computer ai, mirrored)
+*   without a window. Every seed is played twice, once with the old coin flip ai and once
+*   with the lookahead, first to --goals points. Prints win rates and the search metrics:
+*   rollouts per frame and frames over budget.
+*
+*   usage: ai_tournament [--matches n] [--goals n] [--budget us] [--rollouts n] [--seed n]
+*          --rollouts runs a fixed number of rollouts per frame instead of the time budget
+*
+********************************************************************************************/
+
+#define PONG_HEADLESS
+#include "../main.c"
+#include <string.h>
+#include "../softrender.h"
+
+#define TOURNAMENT_MAX_FRAMES (60*60*3) /* three minutes of game time without a winner is a draw */
+
+typedef struct Result {
+    int wins, losses, draws, goals_for, goals_against;
+    long frames;
+    struct LookaheadStats search;
+} Result;
+
+static struct Options {
+    int matches, goals, rollouts;
+    float budget;
+    unsigned int seed;
+} options = {20, 5, 0, LOOKAHEAD_BUDGET_US, 20221004u};
+
+// game as InitGame leaves it, every match starts from a copy
+static Context base;
+static Rules rules;
+static Telemetry *events;
+
+static void play(unsigned int seed, Lookahead *search, Result *result) {
+    Context ctx = base;
+    SetRandomSeed(seed);
+    ctx.board.telemetry = events;
+    ctx.board.lookahead = search;
+    if (search) {
+        lookahead_init(search, rules, options.rollouts > 0 ? 0 : options.budget, seed);
+        if (options.rollouts > 0) search->max_rollouts = options.rollouts;
+    }
+    ctx.human.enable_ai = true;
+    ctx.ball.direction = random_angle();
+    ctx.ball.velocity = ctx.ball.direction;
+    ctx.current_screen = GAMEPLAY;
+    events->active->count = 0;
+    // points come back through the memory sink - human scores when the computer misses
+    int goals[2] = {0};
+    long frame = 0;
+    while (frame < TOURNAMENT_MAX_FRAMES && goals[TELEMETRY_HUMAN] < options.goals && goals[TELEMETRY_COMPUTER] < options.goals) {
+        UpdateFrame(&ctx.screen, &ctx.current_screen, &ctx.board, &ctx.human, &ctx.computer, &ctx.ball, &ctx.arena);
+        soft_end_frame();
+        TelemetryBlock *block = events->active;
+        for (int e=0; e<block->count; e++) {
+            if (block->type[e] == TELEMETRY_POINT) goals[block->side[e]]++;
+        }
+        block->count = 0;
+        frame++;
+    }
+    result->frames += frame;
+    result->goals_for += goals[TELEMETRY_COMPUTER];
+    result->goals_against += goals[TELEMETRY_HUMAN];
+    if (goals[TELEMETRY_COMPUTER] >= options.goals) result->wins++;
+    else if (goals[TELEMETRY_HUMAN] >= options.goals) result->losses++;
+    else result->draws++;
+    if (search) {
+        result->search.frames += search->stats.frames;
+        result->search.rollouts += search->stats.rollouts;
+        result->search.overruns += search->stats.overruns;
+        if (search->stats.worst_us > result->search.worst_us) result->search.worst_us = search->stats.worst_us;
+    }
+}
+
+static void report(const char *name, const Result *result) {
+    int played = result->wins + result->losses + result->draws;
+    printf("%-10s %5d %6d %5d %8.1f%% %6d:%-6d %8ld\n", name, result->wins, result->losses, result->draws,
+           played ? 100.0f*result->wins/played : 0.0f, result->goals_for, result->goals_against, result->frames);
+}
+
+int main(int argc, char **argv) {
+    for (int i=1; i<argc; i++) {
+        if (!strcmp(argv[i], "--matches") && i + 1 < argc) options.matches = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--goals") && i + 1 < argc) options.goals = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--budget") && i + 1 < argc) options.budget = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--rollouts") && i + 1 < argc) options.rollouts = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) options.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else {
+            fprintf(stderr, "usage: %s [--matches n] [--goals n] [--budget us] [--rollouts n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+    InitWindow(_WINDOW_W, _WINDOW_H, "PONG - Smash!");
+    InitAudioDevice();
+    SetRandomSeed(options.seed);
+    InitGame(&base);
+    rules = lookahead.rules;
+    events = malloc(sizeof(Telemetry));
+    telemetry_open_memory(events);
+
+    Result coin = {0}, search = {0};
+    Lookahead *ai = malloc(sizeof(Lookahead));
+    for (int m=0; m<options.matches; m++) {
+        unsigned int seed = options.seed + 7919u*m;
+        play(seed, NULL, &coin);
+        play(seed, ai, &search);
+    }
+
+    if (options.rollouts > 0) printf("%d matches to %d, %d rollouts per frame\n\n", options.matches, options.goals, options.rollouts);
+    else printf("%d matches to %d, %.0f us budget per frame\n\n", options.matches, options.goals, options.budget);
+    printf("%-10s %5s %6s %5s %9s %13s %8s\n", "computer", "wins", "losses", "draws", "win rate", "goals", "frames");
+    report("coin flip", &coin);
+    report("lookahead", &search);
+    if (search.search.frames > 0) {
+        printf("\nsearch: %.1f rollouts per frame over %ld frames, %ld over budget (%.2f%%), worst %.0f us\n",
+               (float)search.search.rollouts/search.search.frames, search.search.frames, search.search.overruns,
+               100.0f*search.search.overruns/search.search.frames, search.search.worst_us);
+    }
+    free(ai);
+    free(events);
+    UnloadGame(&base);
+    CloseAudioDevice();
+    CloseWindow();
+    return 0;
+}
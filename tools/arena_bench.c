@@ -0,0 +1,81 @@
+/*******************************************************************************************
+*
+*   raylib study [tools/arena_bench.c] - Pong _ headless arena benchmark
+*
+*   Steps the multi-ball arena without a window and prints the tick time for a few ball
+*   counts. The field grows with the ball count so density (and contacts per ball) stays
+*   the same - tick time should grow roughly linearly.
+*
+*   usage: arena_bench [ticks] [count ...]   (default: 600 ticks, 10 1000 10000 balls)
+*
+********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "../arena.h"
+
+#define BENCH_RADIUS 9.0f
+#define BENCH_SPEED 480.0f
+#define BENCH_DENSITY 0.1f /* share of the field covered by balls */
+#define BENCH_WARMUP 60
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static void run(int count, int ticks) {
+    // 16:9 field, never smaller than the game canvas
+    float area = count * 3.14159265f * BENCH_RADIUS*BENCH_RADIUS / BENCH_DENSITY;
+    float h = sqrtf(area*9.0f/16.0f);
+    if (h < 324.0f) h = 324.0f;
+    float w = h*16.0f/9.0f;
+    Arena arena;
+    if (!arena_init(&arena, count, (Rectangle){0,18,w,h}, BENCH_RADIUS, BENCH_SPEED, 1234u)) {
+        fprintf(stderr, "arena_bench: out of memory for %d balls\n", count);
+        return;
+    }
+    // two goal paddles and two blockers in the middle like the game arena
+    arena.paddle_count = 4;
+    arena.paddles[0] = (Rectangle){26, 18 + h/2 - 40, 26, 80};
+    arena.paddles[1] = (Rectangle){w - 52, 18 + h/2 - 40, 26, 80};
+    arena.paddles[2] = (Rectangle){w/2 - 13, 18 + h/4 - 40, 26, 80};
+    arena.paddles[3] = (Rectangle){w/2 - 13, 18 + 3*h/4 - 40, 26, 80};
+    for (int i=0; i<count; i++) {
+        float x = arena.radius + ((i*7919u) % 10007u)/10007.0f * (w - 2*arena.radius);
+        float y = 18 + arena.radius + ((i*104729u) % 10009u)/10009.0f * (h - 2*arena.radius);
+        arena_spawn(&arena, (Vector2){x,y}, (Vector2){0,0});
+    }
+    for (int t=0; t<BENCH_WARMUP; t++) arena_step(&arena, 1.0f/60.0f);
+
+    long pair_tests = 0, relinked = 0, ball_hits = 0;
+    double start = now_seconds();
+    for (int t=0; t<ticks; t++) {
+        arena_step(&arena, 1.0f/60.0f);
+        pair_tests += arena.stats.pair_tests;
+        relinked += arena.stats.relinked;
+        ball_hits += arena.stats.ball_hits;
+    }
+    double elapsed = now_seconds() - start;
+    double us_tick = elapsed*1e6/ticks;
+    printf("%8d %10.2f %10.1f %12.1f %10.1f %10.1f\n", count, us_tick, us_tick*1e3/count,
+           (double)pair_tests/ticks, (double)relinked/ticks, (double)ball_hits/ticks);
+    arena_free(&arena);
+}
+
+int main(int argc, char **argv) {
+    int ticks = (argc > 1) ? atoi(argv[1]) : 600;
+    if (ticks <= 0) ticks = 600;
+    printf("%8s %10s %10s %12s %10s %10s\n", "balls", "us/tick", "ns/ball", "pairs/tick", "relink", "hits");
+    if (argc > 2) {
+        for (int i=2; i<argc; i++) run(atoi(argv[i]), ticks);
+    } else {
+        run(10, ticks);
+        run(1000, ticks);
+        run(10000, ticks);
+    }
+    return 0;
+}
@@ -0,0 +1,544 @@
+/*******************************************************************************************
+*
+*   raylib study [tools/fuzz_rules.c] - Pong _ physics invariant fuzzer
+*
+*   Steps the match rules (UpdateFrame, no drawing) from random ball / paddle states the game
+*   can reach (serve, paddle hit or corner hit velocities with their speeds) and random key
+*   sequences on every core, and checks after each tick:
+*       - wall:       the ball center never gets past the outer edge of a wall
+*       - double_hit: a paddle hits the ball at most once per approach
+*       - score:      scores never go down and never go over MAX_SCORE
+*       - nonfinite:  ball and paddle state stays finite
+*   The first failing case of each kind is shrunk (shorter run, fewer keys, plainer state)
+*   and printed as a one line reproducer, --replay steps it again with a trace per tick.
+*
+*   usage: fuzz_rules [--seconds s] [--threads n] [--ticks n] [--max-dt s] [--seed n] [--lookahead]
+*          fuzz_rules --replay file
+*
+*   --lookahead lets half of the cases play the computer with the search (2 rollouts a frame).
+*   Hits are read back from a telemetry memory sink, a run that overflows it fails too.
+*
+********************************************************************************************/
+
+#define PONG_HEADLESS
+#include "../main.c"
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../softrender.h"
+
+#define FUZZ_MAX_TICKS 256
+#define FUZZ_BATCH 256
+
+enum { INPUT_UP = 1, INPUT_DOWN = 2, INPUT_SHIFT = 4, INPUT_SMASH = 8, INPUT_AI = 16 };
+
+typedef enum Violation { FUZZ_OK = 0, FUZZ_WALL, FUZZ_DOUBLE_HIT, FUZZ_SCORE, FUZZ_NONFINITE, FUZZ_VIOLATIONS } Violation;
+
+static const char *violation_names[FUZZ_VIOLATIONS] = {"ok", "wall", "double_hit", "score", "nonfinite"};
+
+typedef struct FuzzCase {
+    unsigned int seed; // game random stream
+    bool lookahead;
+    float dt;
+    int ticks;
+    Ball ball;
+    Paddle human, computer;
+    unsigned char input[FUZZ_MAX_TICKS];
+} FuzzCase;
+
+// random numbers from a counter
+typedef struct Source {
+    uint64_t state;
+} Source;
+
+// per thread scratch - the rules write into ctx, hits are read back from the memory sink
+typedef struct Worker {
+    Context ctx;
+    Telemetry *telemetry;
+    Lookahead search;
+    long cases, ticks, dropped;
+    long found[FUZZ_VIOLATIONS];
+} Worker;
+
+static struct Options {
+    double seconds;
+    int threads, ticks;
+    float max_dt;
+    uint64_t seed;
+    bool lookahead;
+    const char *replay;
+} options = {10.0, 0, 32, 0.05f, 0, false, NULL};
+
+// game as InitGame leaves it, every case starts from a copy
+static Context base;
+
+static atomic_long next_case;
+static atomic_bool stop;
+static pthread_mutex_t found_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct Found { bool found; long index; FuzzCase c; } found[FUZZ_VIOLATIONS];
+
+// -- case generation
+static uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static uint32_t next_u32(Source *src) {
+    src->state += 0x9E3779B97F4A7C15ull;
+    return (uint32_t)(mix64(src->state) >> 32);
+}
+
+static float uniform(Source *src, float lo, float hi) {
+    return lo + (hi - lo)*(next_u32(src) >> 8)*(1.0f/16777216.0f);
+}
+
+static bool chance(Source *src, float p) {
+    return (next_u32(src) >> 8) < p*16777216.0f;
+}
+
+static void place_paddle(Paddle *paddle, float x, float y) {
+    paddle->position = (Vector2){x, y};
+    paddle->rec = (Rectangle){x, y, paddle->paddle_width, paddle->paddle_height};
+    paddle->helper.position = paddle->position;
+    paddle->helper.rec = paddle->rec;
+}
+
+// anywhere the paddle can be - same clamp range as move_*_paddle, knockback shifts x
+static void random_paddle(Source *src, Paddle *paddle, float bottom) {
+    float x = paddle->orig_pos.x + uniform(src, -6.0f, 6.0f);
+    place_paddle(paddle, x, uniform(src, base.board.font_size + 2, bottom));
+    uint32_t r = next_u32(src);
+    if ((r & 3) == 1) paddle->score = (int)(r >> 8) % (MAX_SCORE + 1);
+    else if ((r & 3) >= 2) paddle->score = MAX_SCORE - (int)(r >> 8) % 24;
+    paddle->smash = chance(src, 0.25f);
+}
+
+static bool corner_velocity(Vector2 velocity) {
+    return fabsf(velocity.x) == 0.3f && fabsf(velocity.y) == 0.3f;
+}
+
+// the ball / paddle combinations move_ball can produce - corner_speed 3 comes with a paddle's
+// corner_hit until the next reset, a ±0.3 diagonal with the corner_hit of the paddle that sent it
+static bool reachable(const FuzzCase *c) {
+    const Ball *ball = &c->ball;
+    bool corner = c->human.corner_hit || c->computer.corner_hit;
+    if ((ball->corner_speed == 3.0f) != corner) return false;
+    if (corner_velocity(ball->velocity) && !(ball->velocity.x > 0 ? c->human.corner_hit : c->computer.corner_hit)) return false;
+    return ball->corner_speed == 3.0f || !corner_velocity(ball->velocity);
+}
+
+// smash speeds come from whole degrees, like GetRandomValue in move_ball
+static float random_smash(Source *src) {
+    switch (next_u32(src) % 4) {
+        case 0: return (35 + next_u32(src) % 11) * (PI/180) * 2.1f;
+        case 1: return (25 + next_u32(src) % 11) * (PI/180) * 1.6f;
+        default: return 1.0f;
+    }
+}
+
+static void generate(Source *src, int ticks, FuzzCase *c) {
+    const Screen *screen = &base.screen;
+    const Board *board = &base.board;
+    memset(c, 0, sizeof(*c));
+    c->seed = next_u32(src) | 1;
+    c->ticks = ticks;
+    switch (next_u32(src) % 4) {
+        case 0: c->dt = 1.0f/60.0f; break;
+        case 1: c->dt = 1.0f/30.0f; break;
+        case 2: c->dt = 1.0f/144.0f; break;
+        default: c->dt = uniform(src, 0.001f, options.max_dt); break;
+    }
+    // ball anywhere between the walls, velocity from one of the places move_ball sets it
+    Ball *ball = &c->ball;
+    *ball = base.ball;
+    ball->position.x = uniform(src, 0, screen->canvas_width);
+    ball->position.y = uniform(src, board->wall_w + ball->radius, screen->canvas_height - (board->wall_w + ball->radius));
+    c->human = base.human;
+    c->computer = base.computer;
+    random_paddle(src, &c->human, screen->canvas_height - (c->human.paddle_height + board->font_size));
+    random_paddle(src, &c->computer, screen->canvas_height - (c->computer.paddle_height + c->computer.paddle_width));
+    float sx = chance(src, 0.5f) ? 1.0f : -1.0f, sy = chance(src, 0.5f) ? 1.0f : -1.0f;
+    switch (next_u32(src) % 3) {
+        case 0:
+            {
+                // serve - random_angle, whole degrees, first rally at min speed
+                float angle = (45 + next_u32(src) % 51) * (PI/180);
+                ball->velocity = (Vector2){sx*fabsf(sinf(angle))*0.8f, sy*cosf(angle)*0.8f};
+                ball->speed = ball->min_speed;
+            }break;
+        case 1:
+            {
+                // paddle hit - up to ~60 degrees when the ball meets the paddle end, walls flip y
+                float angle = uniform(src, -60, 60) * (PI/180);
+                ball->velocity = (Vector2){sx*cosf(angle), -sinf(angle)};
+                ball->speed = uniform(src, ball->min_speed, ball->max_speed);
+                ball->smash_speed = random_smash(src);
+                // a corner hit earlier in the rally keeps the speed up
+                if (chance(src, 0.2f)) {
+                    ball->corner_speed = 3.0f;
+                    if (chance(src, 0.5f)) c->human.corner_hit = true;
+                    else c->computer.corner_hit = true;
+                }
+            }break;
+        default:
+            {
+                // corner hit - fixed diagonal away from the paddle that made it
+                ball->velocity = (Vector2){sx*0.3f, sy*0.3f};
+                ball->speed = uniform(src, ball->min_speed, ball->max_speed);
+                ball->smash_speed = random_smash(src);
+                ball->corner_speed = 3.0f;
+                if (sx > 0) c->human.corner_hit = true;
+                else c->computer.corner_hit = true;
+                if (chance(src, 0.2f)) (sx > 0 ? &c->computer : &c->human)->corner_hit = true;
+            }break;
+    }
+    ball->direction = ball->velocity;
+    c->human.enable_ai = chance(src, 0.5f);
+    // held keys change often, presses are rare
+    for (int t=0; t<ticks; t++) {
+        uint32_t r = next_u32(src);
+        c->input[t] = ((r & 0xFF) < 77 ? INPUT_UP : 0) | (((r >> 8) & 0xFF) < 77 ? INPUT_DOWN : 0) |
+                      (((r >> 16) & 0xFF) < 26 ? INPUT_SHIFT : 0) | (((r >> 24) & 0x0F) == 0 ? INPUT_SMASH : 0) |
+                      ((r >> 24) == 0xFF ? INPUT_AI : 0);
+    }
+    // drawn last so the rest of the case does not depend on the option
+    bool search = chance(src, 0.5f);
+    c->lookahead = options.lookahead && search;
+}
+
+// -- stepping
+static bool finite_state(const Context *ctx) {
+    const Ball *ball = &ctx->ball;
+    return isfinite(ball->position.x) && isfinite(ball->position.y) && isfinite(ball->velocity.x) && isfinite(ball->velocity.y) &&
+           isfinite(ball->speed) && isfinite(ball->smash_speed) && isfinite(ball->corner_speed) &&
+           isfinite(ctx->human.position.x) && isfinite(ctx->human.position.y) && isfinite(ctx->human.velocity.y) &&
+           isfinite(ctx->computer.position.x) && isfinite(ctx->computer.position.y) && isfinite(ctx->computer.velocity.y);
+}
+
+static void trace_tick(const Context *ctx, int tick, unsigned char input, const TelemetryBlock *events) {
+    static const char *event_names[TELEMETRY_EVENT_COUNT] = {"hit", "corner", "smash", "smash_back", "wall", "point"};
+    static const char *side_names[] = {"human", "computer", ""};
+    const Ball *ball = &ctx->ball;
+    printf("%4d %-8s in=%02x ball %8.2f %8.2f v %6.3f %6.3f x%-7.1f human %6.1f %5d computer %6.1f %5d",
+           tick, ctx->current_screen == GAMEPLAY ? "gameplay" : "reset", input, ball->position.x, ball->position.y,
+           ball->velocity.x, ball->velocity.y, ball->speed*ball->smash_speed*ball->corner_speed,
+           ctx->human.position.y, ctx->human.score, ctx->computer.position.y, ctx->computer.score);
+    for (int e=0; e<events->count; e++) printf(" %s:%s", event_names[events->type[e]], side_names[events->side[e]]);
+    printf("\n");
+}
+
+// returns the first violation, fail_tick is the tick it showed up on
+static Violation run_case(Worker *w, const FuzzCase *c, int *fail_tick, bool trace) {
+    Context *ctx = &w->ctx;
+    *ctx = base;
+    ctx->board.telemetry = w->telemetry;
+    ctx->board.lookahead = NULL;
+    if (c->lookahead) {
+        lookahead_init(&w->search, lookahead.rules, 0, c->seed);
+        w->search.max_rollouts = 2;
+        ctx->board.lookahead = &w->search;
+    }
+    ctx->ball = c->ball;
+    ctx->human = c->human;
+    ctx->computer = c->computer;
+    ctx->current_screen = GAMEPLAY;
+    TelemetryBlock *events = w->telemetry->active;
+    events->count = 0;
+    w->telemetry->dropped = 0;
+    SetRandomSeed(c->seed);
+    soft_set_frame_time(c->dt);
+    int hits[2] = {0}, heading = 0;
+    for (int t=0; t<c->ticks; t++) {
+        unsigned char input = c->input[t];
+        soft_set_key_down(KEY_UP, input & INPUT_UP);
+        soft_set_key_down(KEY_DOWN, input & INPUT_DOWN);
+        soft_set_key_down(KEY_LEFT_SHIFT, input & INPUT_SHIFT);
+        if (input & INPUT_SMASH) soft_press_key(KEY_SPACE);
+        if (input & INPUT_AI) soft_press_key(KEY_P);
+        // an approach starts when the ball turns toward a paddle - human is on the right
+        int toward = (ctx->ball.velocity.x > 0) - (ctx->ball.velocity.x < 0);
+        if (toward != heading) {
+            heading = toward;
+            if (toward > 0) hits[TELEMETRY_HUMAN] = 0;
+            if (toward < 0) hits[TELEMETRY_COMPUTER] = 0;
+        }
+        int human_score = ctx->human.score, computer_score = ctx->computer.score;
+
+        UpdateFrame(&ctx->screen, &ctx->current_screen, &ctx->board, &ctx->human, &ctx->computer, &ctx->ball, &ctx->arena);
+        soft_end_frame();
+
+        Violation v = FUZZ_OK;
+        for (int e=0; e<events->count; e++) {
+            if (events->type[e] != TELEMETRY_PADDLE_HIT && events->type[e] != TELEMETRY_CORNER_HIT) continue;
+            if (++hits[events->side[e]] > 1) v = FUZZ_DOUBLE_HIT;
+        }
+        if (ctx->human.score < human_score || ctx->human.score > MAX_SCORE) v = FUZZ_SCORE;
+        if (ctx->computer.score < computer_score || ctx->computer.score > MAX_SCORE) v = FUZZ_SCORE;
+        if (ctx->ball.position.y < 0 || ctx->ball.position.y > ctx->screen.canvas_height) v = FUZZ_WALL;
+        if (!finite_state(ctx)) v = FUZZ_NONFINITE;
+        if (trace) trace_tick(ctx, t, input, events);
+        events->count = 0;
+        if (v != FUZZ_OK) {
+            *fail_tick = t;
+            return v;
+        }
+    }
+    *fail_tick = -1;
+    return FUZZ_OK;
+}
+
+static Worker *worker_new(void) {
+    Worker *w = calloc(1, sizeof(Worker));
+    w->telemetry = malloc(sizeof(Telemetry));
+    telemetry_open_memory(w->telemetry);
+    return w;
+}
+
+static void worker_free(Worker *w) {
+    free(w->telemetry);
+    free(w);
+}
+
+// -- shrinking
+static bool simplify(FuzzCase *c, int step) {
+    FuzzCase before = *c;
+    switch (step) {
+        case 0: c->dt = 1.0f/60.0f; break;
+        case 1: c->ball.smash_speed = 1.0f; break;
+        case 2:
+            {
+                c->ball.corner_speed = 1.0f;
+                c->human.corner_hit = false;
+                c->computer.corner_hit = false;
+            }break;
+        case 3: c->ball.speed = c->ball.min_speed; break;
+        case 4: c->human.smash = false; break;
+        case 5: c->computer.smash = false; break;
+        case 6: c->human.corner_hit = false; break;
+        case 7: c->computer.corner_hit = false; break;
+        case 8: c->human.enable_ai = false; break;
+        case 9: c->human.score = 0; break;
+        case 10: c->computer.score = 0; break;
+        case 11: place_paddle(&c->human, c->human.orig_pos.x, c->human.position.y); break;
+        case 12: place_paddle(&c->computer, c->computer.orig_pos.x, c->computer.position.y); break;
+        case 13: place_paddle(&c->human, c->human.position.x, roundf(c->human.position.y)); break;
+        case 14: place_paddle(&c->computer, c->computer.position.x, roundf(c->computer.position.y)); break;
+        case 15: c->ball.position = (Vector2){roundf(c->ball.position.x), roundf(c->ball.position.y)}; break;
+        case 16: c->ball.speed = roundf(c->ball.speed); break;
+        case 17: c->seed = 1; break;
+        case 18: c->lookahead = false; break;
+        default: return false;
+    }
+    // a plainer state the game can not get into is no reproducer
+    return memcmp(&before, c, sizeof(*c)) != 0 && reachable(c);
+}
+
+// keeps any change that still fails the same way, until nothing more goes
+static void shrink(Worker *w, FuzzCase *c, Violation kind) {
+    int tick;
+    if (run_case(w, c, &tick, false) != kind) return;
+    c->ticks = tick + 1;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int t=0; t<c->ticks; t++) {
+            if (!c->input[t]) continue;
+            FuzzCase trial = *c;
+            trial.input[t] = 0;
+            if (run_case(w, &trial, &tick, false) == kind) {
+                *c = trial;
+                c->ticks = tick + 1;
+                changed = true;
+            }
+        }
+        for (int step=0; step<32; step++) {
+            FuzzCase trial = *c;
+            if (!simplify(&trial, step)) continue;
+            if (run_case(w, &trial, &tick, false) == kind) {
+                *c = trial;
+                c->ticks = tick + 1;
+                changed = true;
+            }
+        }
+    }
+}
+
+// -- reproducer - one line, floats with enough digits to round trip
+static void print_case(FILE *out, const FuzzCase *c, Violation kind) {
+    const Ball *b = &c->ball;
+    const Paddle *h = &c->human, *k = &c->computer;
+    fprintf(out, "pong-fuzz %s dt=%.9g seed=%u lookahead=%d ball=%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g human=%.9g,%.9g,%d,%d,%d,%d computer=%.9g,%.9g,%d,%d,%d inputs=",
+            violation_names[kind], c->dt, c->seed, c->lookahead,
+            b->position.x, b->position.y, b->velocity.x, b->velocity.y, b->speed, b->smash_speed, b->corner_speed,
+            h->position.x, h->position.y, h->score, h->smash, h->corner_hit, h->enable_ai,
+            k->position.x, k->position.y, k->score, k->smash, k->corner_hit);
+    for (int t=0; t<c->ticks; t++) fprintf(out, "%02x", c->input[t]);
+    fprintf(out, "\n");
+}
+
+static bool parse_case(const char *line, FuzzCase *c) {
+    char kind[32], inputs[2*FUZZ_MAX_TICKS + 1];
+    float hx, hy, kx, ky;
+    int search, hs, hsmash, hcorner, hai, ks, ksmash, kcorner;
+    memset(c, 0, sizeof(*c));
+    c->ball = base.ball;
+    c->human = base.human;
+    c->computer = base.computer;
+    Ball *b = &c->ball;
+    // %512 is 2*FUZZ_MAX_TICKS hex digits
+    int n = sscanf(line, "pong-fuzz %31s dt=%g seed=%u lookahead=%d ball=%g,%g,%g,%g,%g,%g,%g human=%g,%g,%d,%d,%d,%d computer=%g,%g,%d,%d,%d inputs=%512[0-9a-f]",
+                   kind, &c->dt, &c->seed, &search, &b->position.x, &b->position.y, &b->velocity.x, &b->velocity.y, &b->speed, &b->smash_speed, &b->corner_speed,
+                   &hx, &hy, &hs, &hsmash, &hcorner, &hai, &kx, &ky, &ks, &ksmash, &kcorner, inputs);
+    if (n != 23) return false;
+    c->lookahead = search;
+    place_paddle(&c->human, hx, hy);
+    c->human.score = hs;
+    c->human.smash = hsmash;
+    c->human.corner_hit = hcorner;
+    c->human.enable_ai = hai;
+    place_paddle(&c->computer, kx, ky);
+    c->computer.score = ks;
+    c->computer.smash = ksmash;
+    c->computer.corner_hit = kcorner;
+    c->ticks = (int)strlen(inputs)/2;
+    for (int t=0; t<c->ticks; t++) {
+        unsigned int value;
+        sscanf(inputs + 2*t, "%2x", &value);
+        c->input[t] = (unsigned char)value;
+    }
+    return c->ticks > 0;
+}
+
+static void init_base(void) {
+    InitWindow(_WINDOW_W, _WINDOW_H, "PONG - Smash!");
+    InitAudioDevice();
+    SetRandomSeed(1);
+    InitGame(&base);
+    // workers bring their own sinks and search, the ones in main.c are not thread safe
+    base.board.telemetry = NULL;
+    base.board.lookahead = NULL;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static void *worker_main(void *arg) {
+    Worker *w = arg;
+    FuzzCase c;
+    while (!atomic_load(&stop)) {
+        long first = atomic_fetch_add(&next_case, FUZZ_BATCH);
+        for (long i=first; i<first+FUZZ_BATCH; i++) {
+            // every case comes from (seed, index) alone
+            Source src = {mix64(options.seed ^ (uint64_t)i*0xD1B54A32D192ED03ull)};
+            generate(&src, options.ticks, &c);
+            int tick;
+            Violation v = run_case(w, &c, &tick, false);
+            w->cases++;
+            w->dropped += w->telemetry->dropped;
+            w->ticks += (v != FUZZ_OK) ? tick + 1 : c.ticks;
+            if (v == FUZZ_OK) continue;
+            w->found[v]++;
+            pthread_mutex_lock(&found_lock);
+            if (!found[v].found || i < found[v].index) found[v] = (struct Found){true, i, c};
+            pthread_mutex_unlock(&found_lock);
+        }
+    }
+    return NULL;
+}
+
+static int replay(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "fuzz_rules: unable to open %s\n", path);
+        return 1;
+    }
+    char line[2048];
+    FuzzCase c;
+    bool ok = fgets(line, sizeof(line), file) && parse_case(line, &c);
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "fuzz_rules: %s is not a reproducer\n", path);
+        return 1;
+    }
+    if (!reachable(&c)) printf("note: the game can not reach this ball / paddle state\n");
+    Worker *w = worker_new();
+    int tick;
+    Violation v = run_case(w, &c, &tick, true);
+    if (w->telemetry->dropped) printf("%ld event(s) dropped by a full memory sink\n", w->telemetry->dropped);
+    if (v != FUZZ_OK) printf("%s at tick %d\n", violation_names[v], tick);
+    else printf("no violation in %d ticks\n", c.ticks);
+    worker_free(w);
+    return v != FUZZ_OK;
+}
+
+int main(int argc, char **argv) {
+    options.seed = (uint64_t)time(NULL);
+    for (int i=1; i<argc; i++) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) options.seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc) options.threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) options.ticks = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--max-dt") && i + 1 < argc) options.max_dt = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) options.seed = strtoull(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--lookahead")) options.lookahead = true;
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) options.replay = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--seconds s] [--threads n] [--ticks n] [--max-dt s] [--seed n] [--lookahead] | --replay file\n", argv[0]);
+            return 1;
+        }
+    }
+    if (options.ticks < 1) options.ticks = 1;
+    if (options.ticks > FUZZ_MAX_TICKS) options.ticks = FUZZ_MAX_TICKS;
+    if (options.threads <= 0) options.threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (options.threads <= 0) options.threads = 1;
+    init_base();
+    if (options.replay) return replay(options.replay);
+
+    Worker **workers = calloc(options.threads, sizeof(Worker *));
+    pthread_t *threads = calloc(options.threads, sizeof(pthread_t));
+    double start = now_seconds();
+    for (int t=0; t<options.threads; t++) {
+        workers[t] = worker_new();
+        pthread_create(&threads[t], NULL, worker_main, workers[t]);
+    }
+    while (now_seconds() - start < options.seconds) usleep(20000);
+    atomic_store(&stop, true);
+    long cases = 0, ticks = 0, dropped = 0, counts[FUZZ_VIOLATIONS] = {0};
+    for (int t=0; t<options.threads; t++) {
+        pthread_join(threads[t], NULL);
+        cases += workers[t]->cases;
+        ticks += workers[t]->ticks;
+        dropped += workers[t]->dropped;
+        for (int v=0; v<FUZZ_VIOLATIONS; v++) counts[v] += workers[t]->found[v];
+    }
+    double seconds = now_seconds() - start;
+
+    printf("seed %llu, %d thread(s), %d ticks per case%s, %.1f s\n", (unsigned long long)options.seed, options.threads, options.ticks,
+           options.lookahead ? ", lookahead" : "", seconds);
+    printf("%ld cases, %ld ticks - %.2f M cases/s, %.1f M ticks/s\n", cases, ticks, cases/seconds*1e-6, ticks/seconds*1e-6);
+    int failed = 0;
+    for (int v=1; v<FUZZ_VIOLATIONS; v++) {
+        printf("  %-10s %ld\n", violation_names[v], counts[v]);
+        if (found[v].found) failed++;
+    }
+    if (dropped) {
+        // lost hits hide double hits, the memory sink has to hold a whole tick
+        printf("  %ld event(s) dropped by a full memory sink\n", dropped);
+        failed++;
+    }
+    for (int v=1; v<FUZZ_VIOLATIONS; v++) {
+        if (!found[v].found) continue;
+        FuzzCase c = found[v].c;
+        shrink(workers[0], &c, v);
+        printf("\ncase %ld, shrunk to %d tick(s):\n", found[v].index, c.ticks);
+        print_case(stdout, &c, v);
+    }
+    for (int t=0; t<options.threads; t++) worker_free(workers[t]);
+    free(workers);
+    free(threads);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,167 @@
+/*******************************************************************************************
+*
+*   raylib study [tools/idle_bench.c] - Pong _ on demand rendering benchmark
+*
+*   Runs the game on the software render backend through a title screen wait, a match
+*   with the human paddle ai and a hidden window, once drawing every frame and once with
+*   on demand rendering. Prints per minute of game time: loop frames, update ticks, scene
+*   passes, crt presents and cpu time. The software crt stands in for the gpu, so cpu time
+*   here is an upper bound of what a skipped pass saves.
+*
+*   Also checks the on demand picture: after the title wait the window is compared to a
+*   full redraw, and the first frame back from hidden must not move the ball. And input on
+*   idle frames: a key runs once however many ticks the frame catches up, and a tap between
+*   two polls still lands.
+*
+*   usage: idle_bench [--seconds n] [--seed n]
+*
+********************************************************************************************/
+
+#define PONG_HEADLESS
+#include "../main.c"
+#include <string.h>
+#include "../softrender.h"
+
+typedef struct Sample {
+    const char *state;
+    struct RenderStats stats;
+    double cpu_ms;
+} Sample;
+
+static struct Options {
+    float seconds;
+    unsigned int seed;
+} options = {60.0f, 20221004u};
+
+static int failures = 0;
+
+static void step(Context *ctx) {
+    UpdateDrawFrame(&ctx->screen, &ctx->current_screen, &ctx->board, &ctx->human, &ctx->computer, &ctx->ball, &ctx->arena);
+}
+
+// frames until the virtual clock moved by --seconds, counters as the difference
+static Sample measure(Context *ctx, const char *state) {
+    Sample sample = {state};
+    struct RenderStats before = ctx->screen.stats;
+    double end = GetTime() + options.seconds;
+    clock_t start = clock();
+    while (GetTime() < end) step(ctx);
+    sample.cpu_ms = 1000.0*(clock() - start)/CLOCKS_PER_SEC;
+    sample.stats.frames = ctx->screen.stats.frames - before.frames;
+    sample.stats.ticks = ctx->screen.stats.ticks - before.ticks;
+    sample.stats.scenes = ctx->screen.stats.scenes - before.scenes;
+    sample.stats.presents = ctx->screen.stats.presents - before.presents;
+    return sample;
+}
+
+static void report(const char *mode, const Sample *sample) {
+    float minutes = options.seconds/60.0f;
+    printf("%-10s %-10s %8.0f %8.0f %8.0f %8.0f %10.1f\n", sample->state, mode, sample->stats.frames/minutes,
+           sample->stats.ticks/minutes, sample->stats.scenes/minutes, sample->stats.presents/minutes, sample->cpu_ms/minutes);
+}
+
+// window after a skipped frame against the same frame drawn in full
+static void check_picture(Context *ctx) {
+    Image shown = soft_screenshot();
+    DrawFrame(&ctx->screen, &ctx->current_screen, &ctx->board, &ctx->human, &ctx->computer, &ctx->ball, &ctx->arena, true, true);
+    Image drawn = soft_screenshot();
+    int bad = 0;
+    Color *a = shown.data, *b = drawn.data;
+    for (int i=0; i<shown.width*shown.height; i++) bad += memcmp(&a[i], &b[i], sizeof(Color)) != 0;
+    if (bad) {
+        printf("picture: FAIL %i pixels differ from a full redraw\n", bad);
+        failures++;
+    } else printf("picture: ok, idle title matches a full redraw\n");
+    UnloadImage(shown);
+    UnloadImage(drawn);
+}
+
+// SPACE on the idle logo jumps to frame 80 once, catch-up ticks count on from there
+static void check_replay(Context *ctx) {
+    for (int i=0; i<200 && !ctx->screen.idle; i++) step(ctx);
+    long ticks = ctx->screen.stats.ticks;
+    soft_press_key(KEY_SPACE);
+    step(ctx);
+    int expected = 80 + (int)(ctx->screen.stats.ticks - ticks) - 1;
+    if (expected <= 80 || ctx->board.timer.frame_counter != expected) {
+        printf("replay: FAIL logo at frame %i after SPACE, expected %i\n", ctx->board.timer.frame_counter, expected);
+        failures++;
+    } else printf("replay: ok, SPACE on the idle logo ran once over %li ticks\n", ctx->screen.stats.ticks - ticks);
+}
+
+// press and release inside one idle frame - only the key queue has it
+static void check_tap(Context *ctx) {
+    soft_tap_key(KEY_ENTER);
+    step(ctx);
+    if (!ctx->board.blink) {
+        printf("tap: FAIL ENTER tapped on the idle title was lost\n");
+        failures++;
+    } else printf("tap: ok, ENTER tapped on the idle title starts the match\n");
+}
+
+static void run(bool on_demand) {
+    const char *mode = on_demand ? "on demand" : "always";
+    SetRandomSeed(options.seed);
+    soft_set_frame_time(1.0f/TICK_RATE);
+    soft_set_hidden(false);
+    Context ctx = {0};
+    InitGame(&ctx);
+    ctx.screen.on_demand = on_demand;
+    lookahead.budget_us = 0;
+    lookahead.max_rollouts = 64;
+    // skip the logo
+    step(&ctx);
+    if (on_demand) check_replay(&ctx);
+    else soft_press_key(KEY_SPACE);
+    while (ctx.current_screen != TITLE) step(&ctx);
+    Sample title = measure(&ctx, "title");
+    if (on_demand) {
+        check_picture(&ctx);
+        check_tap(&ctx);
+    }
+    // match - the human paddle ai keeps the rallies going
+    soft_press_key(KEY_ENTER);
+    while (ctx.current_screen != GAMEPLAY) step(&ctx);
+    soft_press_key(KEY_P);
+    Sample match = measure(&ctx, "match");
+    // hidden window mid rally
+    while (ctx.current_screen != GAMEPLAY) step(&ctx);
+    soft_set_hidden(true);
+    Sample hidden = measure(&ctx, "hidden");
+    soft_set_hidden(false);
+    if (on_demand) {
+        Vector2 before = ctx.ball.position;
+        step(&ctx);
+        float moved = Vector2Distance(before, ctx.ball.position);
+        if (moved > 0) {
+            printf("resume: FAIL ball moved %.1f px on the first frame back\n", moved);
+            failures++;
+        } else printf("resume: ok, first frame back holds the ball\n");
+    }
+    report(mode, &title);
+    report(mode, &match);
+    report(mode, &hidden);
+    UnloadGame(&ctx);
+}
+
+int main(int argc, char **argv) {
+    for (int i=1; i<argc; i++) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) options.seconds = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) options.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else {
+            fprintf(stderr, "usage: %s [--seconds n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (options.seconds <= 0) options.seconds = 60.0f;
+    InitWindow(_WINDOW_W, _WINDOW_H, "PONG - Smash!");
+    InitAudioDevice();
+    printf("per minute of game time\n");
+    printf("%-10s %-10s %8s %8s %8s %8s %10s\n", "state", "mode", "frames", "ticks", "scenes", "presents", "cpu ms");
+    run(false);
+    run(true);
+    CloseAudioDevice();
+    CloseWindow();
+    if (failures) printf("%i check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,210 @@
+/*******************************************************************************************
+*
+*   raylib study [tools/render_regress.c] - Pong _ headless visual regression
+*
+*   Builds the game on top of the software render backend, plays scripted sessions with a
+*   fixed seed and a fixed 60 Hz clock, and compares captured frames to the golden PNGs.
+*   A pixel counts as changed when a channel is off by more than the tolerance, a frame
+*   fails when more than --max-bad percent of its pixels changed. Missing goldens fail too.
+*
+*   Goldens are only valid when rendered with raylib 4.2's own stb headers (font atlas and png),
+*   --update refuses any other raylib.h. To refresh them after an intended visual change:
+*       make goldens INCLUDE_PATHS=<raylib 4.2.0>/src, look at the pngs, commit tests/golden
+*
+*   usage: render_regress [--update] [--tolerance n] [--max-bad percent] [--golden dir] [--out dir]
+*
+********************************************************************************************/
+
+#define PONG_HEADLESS
+#include "../main.c"
+#include <string.h>
+#include "../softrender.h"
+
+#define REGRESS_SEED 20221004u
+#define REGRESS_RAYLIB "4.2" /* goldens are only valid for this raylib/src */
+#if defined(RAYLIB_VERSION)
+    #define GOLDEN_RAYLIB RAYLIB_VERSION
+#else
+    #define GOLDEN_RAYLIB "unknown"
+#endif
+
+typedef enum StepType { STEP_PRESS = 0, STEP_HOLD, STEP_RELEASE, STEP_CAPTURE } StepType;
+
+typedef struct Step {
+    int frame;
+    StepType type;
+    int key;
+    const char *name;
+} Step;
+
+typedef struct Session {
+    const char *name;
+    int frames;
+    const Step *steps;
+    int step_count;
+} Session;
+
+static const Step match_steps[] = {
+    { 50, STEP_CAPTURE, 0, "logo"},
+    {110, STEP_CAPTURE, 0, "logo_final"},
+    {190, STEP_CAPTURE, 0, "title"},
+    {200, STEP_PRESS, KEY_ENTER, NULL},
+    {300, STEP_CAPTURE, 0, "start"},
+    {520, STEP_HOLD, KEY_UP, NULL},
+    {540, STEP_RELEASE, KEY_UP, NULL},
+    {560, STEP_CAPTURE, 0, "gameplay"},
+    {600, STEP_PRESS, KEY_SPACE, NULL},
+    {700, STEP_CAPTURE, 0, "gameplay_late"},
+};
+
+static const Step arena_steps[] = {
+    {200, STEP_PRESS, KEY_A, NULL},
+    {560, STEP_CAPTURE, 0, "arena"},
+    {900, STEP_CAPTURE, 0, "arena_crowded"},
+};
+
+// hard ai picked on the title
+static const Step hard_steps[] = {
+    {150, STEP_PRESS, KEY_H, NULL},
+    {190, STEP_CAPTURE, 0, "title_hard"},
+    {200, STEP_PRESS, KEY_ENTER, NULL},
+    {560, STEP_CAPTURE, 0, "gameplay_hard"},
+};
+
+static const Session sessions[] = {
+    {"match", 701, match_steps, sizeof(match_steps)/sizeof(match_steps[0])},
+    {"arena", 901, arena_steps, sizeof(arena_steps)/sizeof(arena_steps[0])},
+    {"hard", 561, hard_steps, sizeof(hard_steps)/sizeof(hard_steps[0])},
+};
+
+static struct Options {
+    bool update;
+    int tolerance;
+    float max_bad;
+    const char *golden, *out;
+} options = {false, 8, 0.1f, "tests/golden", "bin/regress"};
+
+static int failures = 0;
+
+// diff image: changed pixels in red over a dimmed copy of the frame
+static int compare(Image frame, Image golden, Image *diff) {
+    int bad = 0;
+    const Color *a = frame.data, *b = golden.data;
+    Color *d = diff->data;
+    for (int i=0; i<frame.width*frame.height; i++) {
+        int dr = abs(a[i].r - b[i].r), dg = abs(a[i].g - b[i].g), db = abs(a[i].b - b[i].b), da = abs(a[i].a - b[i].a);
+        bool changed = dr > options.tolerance || dg > options.tolerance || db > options.tolerance || da > options.tolerance;
+        if (changed) bad++;
+        d[i] = changed ? RED : (Color){a[i].r/4, a[i].g/4, a[i].b/4, 255};
+    }
+    return bad;
+}
+
+static void check(const char *name) {
+    Image frame = soft_screenshot();
+    const char *golden_path = TextFormat("%s/%s.png", options.golden, name);
+    if (options.update) {
+        if (!ExportImage(frame, golden_path)) {
+            printf("%-16s unable to write %s\n", name, golden_path);
+            failures++;
+        } else printf("%-16s updated\n", name);
+        UnloadImage(frame);
+        return;
+    }
+    Image golden = LoadImage(golden_path);
+    if (!golden.data) {
+        printf("%-16s MISSING %s (run with --update)\n", name, golden_path);
+        failures++;
+    } else if (golden.width != frame.width || golden.height != frame.height) {
+        printf("%-16s FAIL size %ix%i, golden %ix%i\n", name, frame.width, frame.height, golden.width, golden.height);
+        failures++;
+    } else {
+        Image diff = frame;
+        diff.data = malloc(sizeof(Color)*frame.width*frame.height);
+        int bad = compare(frame, golden, &diff);
+        float percent = 100.0f*bad/(frame.width*frame.height);
+        if (percent > options.max_bad) {
+            printf("%-16s FAIL %i pixels (%.3f%%) off by more than %i\n", name, bad, percent, options.tolerance);
+            ExportImage(frame, TextFormat("%s/%s.png", options.out, name));
+            ExportImage(diff, TextFormat("%s/%s_diff.png", options.out, name));
+            failures++;
+        } else printf("%-16s ok %i pixels (%.3f%%)\n", name, bad, percent);
+        UnloadImage(diff);
+    }
+    UnloadImage(golden);
+    UnloadImage(frame);
+}
+
+// a fresh checkout has no goldens until someone renders them against the real stb headers
+static bool have_goldens(void) {
+    for (size_t s=0; s<sizeof(sessions)/sizeof(sessions[0]); s++) {
+        for (int i=0; i<sessions[s].step_count; i++) {
+            if (sessions[s].steps[i].type != STEP_CAPTURE) continue;
+            FILE *file = fopen(TextFormat("%s/%s.png", options.golden, sessions[s].steps[i].name), "rb");
+            if (file) {
+                fclose(file);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void run(const Session *session) {
+    SetRandomSeed(REGRESS_SEED);
+    Context ctx = {0};
+    InitGame(&ctx);
+    // fixed rollouts per frame, a time budget would make the frames depend on the machine
+    lookahead.budget_us = 0;
+    lookahead.max_rollouts = 64;
+    // every frame drawn at 60 Hz, captures are scripted by frame number
+    ctx.screen.on_demand = false;
+    int next = 0;
+    for (int frame=0; frame<session->frames; frame++) {
+        // input goes in before the frame, captures after it
+        for (int s=next; s<session->step_count && session->steps[s].frame == frame; s++) {
+            const Step *step = &session->steps[s];
+            if (step->type == STEP_PRESS) soft_press_key(step->key);
+            if (step->type == STEP_HOLD) soft_set_key_down(step->key, true);
+            if (step->type == STEP_RELEASE) soft_set_key_down(step->key, false);
+        }
+        UpdateDrawFrame(&ctx.screen, &ctx.current_screen, &ctx.board, &ctx.human, &ctx.computer, &ctx.ball, &ctx.arena);
+        for (; next<session->step_count && session->steps[next].frame == frame; next++) {
+            if (session->steps[next].type == STEP_CAPTURE) check(session->steps[next].name);
+        }
+    }
+    UnloadGame(&ctx);
+}
+
+int main(int argc, char **argv) {
+    for (int i=1; i<argc; i++) {
+        if (!strcmp(argv[i], "--update")) options.update = true;
+        else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) options.tolerance = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--max-bad") && i + 1 < argc) options.max_bad = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--golden") && i + 1 < argc) options.golden = argv[++i];
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) options.out = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--update] [--tolerance n] [--max-bad percent] [--golden dir] [--out dir]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (!options.update && !have_goldens()) {
+        fprintf(stderr, "error: no goldens in %s - make goldens against raylib 4.2 src and commit them\n", options.golden);
+        return 1;
+    }
+    // goldens carry the font atlas and png encoding of raylib's own stb copies
+    if (options.update && strcmp(GOLDEN_RAYLIB, REGRESS_RAYLIB) != 0) {
+        fprintf(stderr, "error: goldens are rendered with raylib %s headers, these are %s\n", REGRESS_RAYLIB, GOLDEN_RAYLIB);
+        return 1;
+    }
+    InitWindow(_WINDOW_W, _WINDOW_H, "PONG - Smash!");
+    InitAudioDevice();
+    clock_t start = clock();
+    for (size_t s=0; s<sizeof(sessions)/sizeof(sessions[0]); s++) run(&sessions[s]);
+    double seconds = (double)(clock() - start)/CLOCKS_PER_SEC;
+    printf("\n%ld frames in %.2f s cpu (%.0f fps)\n", soft_frame_count(), seconds, seconds > 0 ? soft_frame_count()/seconds : 0.0);
+    CloseAudioDevice();
+    CloseWindow();
+    if (failures) printf("%i frame(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+/*******************************************************************************************
+*
+*   raylib study [tools/telemetry_stats.c] - Pong _ match telemetry aggregation
+*
+*   Reads telemetry logs written by the game in one streaming pass, a block at a time, so
+*   memory stays the same for a thousand or a hundred million events.
+*       - event counts
+*       - hit angle histogram per side
+*       - smash success rate (smasher wins the point before the ball comes back)
+*       - rally length (paddle hits between points) by the top ball speed of the rally
+*
+*   usage: telemetry_stats <file> [file ...]
+*
+********************************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+#include "../telemetry.h"
+
+#define ANGLE_BIN 10 /* degree */
+#define ANGLE_BINS (180/ANGLE_BIN)
+#define SPEED_BIN 100 /* pixels per second */
+#define SPEED_BINS 24
+
+static const char *event_names[TELEMETRY_EVENT_COUNT] = {"paddle hit","corner hit","smash","smash back","wall hit","point"};
+static const char *side_names[2] = {"human","computer"};
+
+typedef struct Stats {
+    long events, blocks;
+    long count[TELEMETRY_EVENT_COUNT];
+    long angles[2][ANGLE_BINS];
+    long smashes[2], smash_wins[2];
+    long rallies[SPEED_BINS], rally_hits[SPEED_BINS], rally_max[SPEED_BINS];
+    // streaming state carried across blocks and files
+    int smash_side, rally_length, rally_speed;
+} Stats;
+
+static void aggregate(Stats *stats, TelemetryBlock *block) {
+    for (int i=0; i<block->count; i++) {
+        int type = block->type[i];
+        int side = block->side[i];
+        if (type >= TELEMETRY_EVENT_COUNT) continue;
+        stats->count[type]++;
+        switch (type) {
+            case TELEMETRY_PADDLE_HIT:
+            case TELEMETRY_CORNER_HIT:
+                {
+                    if (side > TELEMETRY_COMPUTER) break;
+                    int bin = (block->angle[i] + 9000)/(ANGLE_BIN*100);
+                    if (bin < 0) bin = 0;
+                    if (bin >= ANGLE_BINS) bin = ANGLE_BINS-1;
+                    stats->angles[side][bin]++;
+                    // ball came back - open smash from the other side failed
+                    if (stats->smash_side >= 0 && stats->smash_side != side) stats->smash_side = -1;
+                    stats->rally_length++;
+                    if (block->speed[i] > stats->rally_speed) stats->rally_speed = block->speed[i];
+                }break;
+            case TELEMETRY_SMASH:
+            case TELEMETRY_SMASH_BACK:
+                {
+                    if (side > TELEMETRY_COMPUTER) break;
+                    stats->smashes[side]++;
+                    stats->smash_side = side;
+                }break;
+            case TELEMETRY_POINT:
+                {
+                    if (stats->smash_side >= 0 && stats->smash_side == side) stats->smash_wins[side]++;
+                    stats->smash_side = -1;
+                    int bin = stats->rally_speed/SPEED_BIN;
+                    if (bin >= SPEED_BINS) bin = SPEED_BINS-1;
+                    stats->rallies[bin]++;
+                    stats->rally_hits[bin] += stats->rally_length;
+                    if (stats->rally_length > stats->rally_max[bin]) stats->rally_max[bin] = stats->rally_length;
+                    stats->rally_length = 0;
+                    stats->rally_speed = 0;
+                }break;
+            default: break;
+        }
+    }
+    stats->events += block->count;
+    stats->blocks++;
+}
+
+static void report(Stats *stats, double seconds) {
+    printf("events %ld in %ld blocks (%.1f M events/s)\n\n", stats->events, stats->blocks, seconds > 0 ? stats->events/seconds/1e6 : 0.0);
+    for (int t=0; t<TELEMETRY_EVENT_COUNT; t++) printf("%-12s %ld\n", event_names[t], stats->count[t]);
+
+    printf("\nhit angle      %10s %10s\n", side_names[0], side_names[1]);
+    for (int b=0; b<ANGLE_BINS; b++) {
+        printf("[%4d,%4d)  %10ld %10ld\n", b*ANGLE_BIN-90, (b+1)*ANGLE_BIN-90, stats->angles[0][b], stats->angles[1][b]);
+    }
+
+    printf("\nsmash        attempts       wins       rate\n");
+    for (int s=0; s<2; s++) {
+        double rate = stats->smashes[s] ? 100.0*stats->smash_wins[s]/stats->smashes[s] : 0.0;
+        printf("%-10s %10ld %10ld %9.1f%%\n", side_names[s], stats->smashes[s], stats->smash_wins[s], rate);
+    }
+
+    printf("\nrally speed      rallies   avg hits   max hits\n");
+    for (int b=0; b<SPEED_BINS; b++) {
+        if (!stats->rallies[b]) continue;
+        printf("%5d%s %12ld %10.2f %10ld\n", b*SPEED_BIN, (b == SPEED_BINS-1) ? "+ px/s" : "  px/s", stats->rallies[b],
+               (double)stats->rally_hits[b]/stats->rallies[b], stats->rally_max[b]);
+    }
+}
+
+int main(int argc, char **argv) {
+    static TelemetryBlock block;
+    static Stats stats;
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <file> [file ...]\n", argv[0]);
+        return 1;
+    }
+    stats.smash_side = -1;
+    clock_t start = clock();
+    for (int f=1; f<argc; f++) {
+        FILE *file = fopen(argv[f], "rb");
+        if (!file) {
+            fprintf(stderr, "%s: unable to open\n", argv[f]);
+            return 1;
+        }
+        static char buffer[1 << 16];
+        setvbuf(file, buffer, _IOFBF, sizeof(buffer));
+        if (!telemetry_read_header(file)) {
+            fprintf(stderr, "%s: not a telemetry log\n", argv[f]);
+            fclose(file);
+            return 1;
+        }
+        int n;
+        while ((n = telemetry_read_block(file, &block)) > 0) aggregate(&stats, &block);
+        fclose(file);
+        if (n < 0) {
+            fprintf(stderr, "%s: corrupt block after %ld events\n", argv[f], stats.events);
+            return 1;
+        }
+    }
+    report(&stats, (double)(clock() - start)/CLOCKS_PER_SEC);
+    return 0;
+}